@@ -15,10 +15,14 @@
 #include <ch32v00x_hal_typedef.h>
 #include <ch32v00x_hal_assert.h>
 #include <ch32v00x_hal_tick.h>
+#include <ch32v00x_hal_rcc.h>
 #include <ch32v00x_hal_gpio.h>
 #include <ch32v00x_hal_uart.h>
-#include <ch32v00x_hal_rcc.h>
 #include <ch32v00x_hal_nvic.h>
 #include <ch32v00x_hal_flash.h>
+#include <ch32v00x_hal_pwr.h>
+#include <ch32v00x_hal_async.h>
+#include <ch32v00x_hal_input.h>
+#include <ch32v00x_hal_bitbang.h>
 
 #endif /* __CH32V00X_HAL_H */
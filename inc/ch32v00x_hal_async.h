@@ -0,0 +1,252 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : ch32v00x_hal_async.h
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : Stackless coroutines (protothread style) and awaitable
+ *                      primitives built on top of the HAL interrupt paths
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+#ifndef __CH32V00X_HAL_ASYNC_H
+#define __CH32V00X_HAL_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A coroutine is a plain function taking a HAL_AsyncTypeDef pointer and
+ * returning HAL_AsyncStateTypeDef. Local variables are NOT preserved across
+ * an await, keep them in the caller provided context instead.
+ * A switch() statement must not enclose an await point.
+ *
+ *   HAL_AsyncStateTypeDef Blink(HAL_AsyncTypeDef *ctx)
+ *   {
+ *       HAL_ASYNC_BEGIN(ctx);
+ *       while (1)
+ *       {
+ *           HAL_GPIO_Toggle(GPIOD, GPIO_Pin_0);
+ *           HAL_ASYNC_AWAIT_DELAY_MS(ctx, 500U);
+ *       }
+ *       HAL_ASYNC_END(ctx);
+ *   }
+ *
+ *   while (1) { Blink(&blink); Shell(&shell); __WFI(); }
+ */
+
+/* Exported types ------------------------------------------------------------*/
+/* Coroutine run state */
+typedef enum
+{
+    HAL_ASYNC_WAITING = 0x00U,  /*!< Coroutine is suspended on an await */
+    HAL_ASYNC_DONE    = 0x01U   /*!< Coroutine ran to its end           */
+} HAL_AsyncStateTypeDef;
+
+/* Coroutine context (8 bytes) */
+typedef struct
+{
+    uint16_t Resume;     /* Resume point, 0 means start from the beginning */
+
+    uint8_t  Status;     /* HAL_StatusTypeDef result of the last awaited operation */
+
+    uint8_t  Reserved;
+
+    uint32_t Timestamp;  /* Tick captured when a delay await was entered */
+} HAL_AsyncTypeDef;
+/* Exported macro ------------------------------------------------------------*/
+/**
+  * @brief  Reset a coroutine context, next call starts from the beginning.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  * @retval None
+  */
+#define HAL_ASYNC_INIT(__CTX__)     do { (__CTX__)->Resume = 0U; (__CTX__)->Status = (uint8_t)HAL_OK; } while (0)
+
+/**
+  * @brief  Open / close the coroutine body. Must be the first / last statement.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  */
+#define HAL_ASYNC_BEGIN(__CTX__)    switch ((__CTX__)->Resume) { case 0U:
+
+#define HAL_ASYNC_END(__CTX__)      } (__CTX__)->Resume = 0U; return HAL_ASYNC_DONE
+
+/**
+  * @brief  Suspend the coroutine until __COND__ becomes true.
+  * @note   __COND__ is re-evaluated each time the coroutine is resumed.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  * @param  __COND__ condition to wait for.
+  */
+#define HAL_ASYNC_AWAIT(__CTX__, __COND__)                          \
+    do {                                                            \
+        (__CTX__)->Resume = (uint16_t)__LINE__;                     \
+        case __LINE__:                                              \
+        if (!(__COND__)) { return HAL_ASYNC_WAITING; }              \
+    } while (0)
+
+/**
+  * @brief  Give up the CPU once, resume at the next call.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  */
+#define HAL_ASYNC_YIELD(__CTX__)                                    \
+    do {                                                            \
+        (__CTX__)->Resume = (uint16_t)__LINE__;                     \
+        return HAL_ASYNC_WAITING;                                   \
+        case __LINE__: ;                                            \
+    } while (0)
+
+/**
+  * @brief  Wait at least __MS__ milliseconds without blocking the CPU.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  * @param  __MS__ delay in milliseconds (must not change while waiting).
+  */
+#define HAL_ASYNC_AWAIT_DELAY_MS(__CTX__, __MS__)                   \
+    do {                                                            \
+        (__CTX__)->Timestamp = HAL_GetTick();                       \
+        HAL_ASYNC_AWAIT((__CTX__), HAL_TickExpired((__CTX__)->Timestamp, (__MS__)) != FALSE); \
+    } while (0)
+
+/**
+  * @brief  Send a buffer through HAL_UART_Transmit_IT and wait for the TC interrupt.
+  * @note   Waits for a previous transfer to end if the UART is busy.
+  *         The result is available in __CTX__->Status.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  * @param  __HANDLE__ UART handle.
+  * @param  __DATA__ pointer to data buffer, must stay valid until done.
+  * @param  __SIZE__ amount of data elements to be sent.
+  */
+#define HAL_ASYNC_AWAIT_UART_TX(__CTX__, __HANDLE__, __DATA__, __SIZE__)        \
+    do {                                                                        \
+        (__CTX__)->Status = (uint8_t)HAL_BUSY;                                  \
+        HAL_ASYNC_AWAIT((__CTX__), ASYNC_UART_TxPoll((__CTX__), (__HANDLE__), (__DATA__), (__SIZE__)) != FALSE); \
+    } while (0)
+
+/**
+  * @brief  Receive a buffer through HAL_UART_Receive_IT and wait for completion.
+  * @note   The result is available in __CTX__->Status (HAL_ERROR on overrun).
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  * @param  __HANDLE__ UART handle.
+  * @param  __DATA__ pointer to data buffer.
+  * @param  __SIZE__ amount of data elements to be received.
+  */
+#define HAL_ASYNC_AWAIT_UART_RX(__CTX__, __HANDLE__, __DATA__, __SIZE__)        \
+    do {                                                                        \
+        (__CTX__)->Status = (uint8_t)HAL_BUSY;                                  \
+        HAL_ASYNC_AWAIT((__CTX__), ASYNC_UART_RxPoll((__CTX__), (__HANDLE__), (__DATA__), (__SIZE__)) != FALSE); \
+    } while (0)
+
+/**
+  * @brief  Start an erase through HAL_FLASH_Erase_Start and wait for its end.
+  * @note   Waits for a previous operation to end if the FLASH is busy.
+  *         The result of HAL_FLASH_Finish is available in __CTX__->Status.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  * @param  __HANDLE__ FLASH handle describing the erase (unlocked).
+  */
+#define HAL_ASYNC_AWAIT_FLASH_ERASE(__CTX__, __HANDLE__)                        \
+    do {                                                                        \
+        (__CTX__)->Status = (uint8_t)HAL_BUSY;                                  \
+        HAL_ASYNC_AWAIT((__CTX__), ASYNC_FLASH_ErasePoll((__CTX__), (__HANDLE__)) != FALSE); \
+    } while (0)
+
+/**
+  * @brief  Wait for an operation started with HAL_FLASH_Erase_Start to end.
+  * @note   The result of HAL_FLASH_Finish is available in __CTX__->Status.
+  * @param  __CTX__ pointer to a HAL_AsyncTypeDef.
+  * @param  __HANDLE__ FLASH handle used to start the operation.
+  */
+#define HAL_ASYNC_AWAIT_FLASH_DONE(__CTX__, __HANDLE__)                         \
+    do {                                                                        \
+        (__CTX__)->Status = (uint8_t)HAL_OK;                                    \
+        HAL_ASYNC_AWAIT((__CTX__), ASYNC_FLASH_ErasePoll((__CTX__), (__HANDLE__)) != FALSE); \
+    } while (0)
+
+/* Private inline functions --------------------------------------------------*/
+static inline uint8_t ASYNC_UART_TxPoll(HAL_AsyncTypeDef *ctx, UART_HandleTypeDef *huart,
+                                        const uint8_t *pData, uint16_t Size)
+{
+    /* Not started yet: try to hand the buffer over to the interrupt path */
+    if (ctx->Status == (uint8_t)HAL_BUSY)
+    {
+        ctx->Status = (uint8_t)HAL_UART_Transmit_IT(huart, pData, Size);
+
+        if (ctx->Status == (uint8_t)HAL_BUSY)
+        {
+            return FALSE;
+        }
+    }
+
+    if (ctx->Status != (uint8_t)HAL_OK)
+    {
+        return TRUE;
+    }
+
+    return (huart->gState == HAL_UART_STATE_READY) ? TRUE : FALSE;
+}
+
+static inline uint8_t ASYNC_UART_RxPoll(HAL_AsyncTypeDef *ctx, UART_HandleTypeDef *huart,
+                                        uint8_t *pData, uint16_t Size)
+{
+    if (ctx->Status == (uint8_t)HAL_BUSY)
+    {
+        ctx->Status = (uint8_t)HAL_UART_Receive_IT(huart, pData, Size);
+
+        if (ctx->Status == (uint8_t)HAL_BUSY)
+        {
+            return FALSE;
+        }
+    }
+
+    if (ctx->Status != (uint8_t)HAL_OK)
+    {
+        return TRUE;
+    }
+
+    if (huart->RxState != HAL_UART_STATE_READY)
+    {
+        return FALSE;
+    }
+
+    /* Reception aborted by a blocking error (overrun) */
+    if (huart->RxXferCount != 0U)
+    {
+        ctx->Status = (uint8_t)HAL_ERROR;
+    }
+
+    return TRUE;
+}
+
+static inline uint8_t ASYNC_FLASH_ErasePoll(HAL_AsyncTypeDef *ctx, FLASH_HandleTypeDef *hflash)
+{
+    HAL_StatusTypeDef status;
+
+    /* Not started yet: retry until the controller accepts the erase */
+    if (ctx->Status == (uint8_t)HAL_BUSY)
+    {
+        ctx->Status = (uint8_t)HAL_FLASH_Erase_Start(hflash);
+
+        if (ctx->Status == (uint8_t)HAL_BUSY)
+        {
+            return FALSE;
+        }
+    }
+
+    if (ctx->Status != (uint8_t)HAL_OK)
+    {
+        return TRUE;
+    }
+
+    status = HAL_FLASH_Finish(hflash);
+    if (status == HAL_BUSY)
+    {
+        return FALSE;
+    }
+
+    ctx->Status = (uint8_t)status;
+
+    return TRUE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CH32V00X_HAL_ASYNC_H */
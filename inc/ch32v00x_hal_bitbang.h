@@ -0,0 +1,87 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : ch32v00x_hal_bitbang.h
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : Header file of the bit-bang protocol engines
+ *                      (WS2812, 1-Wire, software UART)
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+#ifndef __CH32V00X_HAL_BITBANG_H
+#define __CH32V00X_HAL_BITBANG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Waveforms are produced with direct BSHR/BCR stores and spin loops whose
+ * cost is measured against SysTick by HAL_BITBANG_Init(). Every phase length
+ * is converted to a loop count once and recomputed on every system clock
+ * change through an RCC clock notifier. The host program
+ * tools/bitbang_timing_model.c replays the loop counts through the cycle
+ * cost of the emitted instruction sequences and checks the waveforms
+ * against the protocol limits.
+ */
+
+/* Exported types ------------------------------------------------------------*/
+/* 1-Wire bus */
+typedef struct
+{
+    GPIO_TypeDef *Port;      /* GPIOx where x can be (A..D), pin configured as GPIO_Mode_Out_OD */
+
+    uint16_t Pin;            /* GPIO_Pin_x where x can be (0..7) */
+} BITBANG_OneWireTypeDef;
+
+/* Software UART, 8N1 */
+typedef struct
+{
+    GPIO_TypeDef *TxPort;    /* Tx port, pin configured as GPIO_Mode_Out_PP, NULL if unused */
+
+    uint16_t TxPin;          /* Tx pin */
+
+    GPIO_TypeDef *RxPort;    /* Rx port, pin configured as an input, NULL if unused */
+
+    uint16_t RxPin;          /* Rx pin */
+
+    uint32_t BaudRate;       /* Baud rate */
+
+    uint32_t BitLoops;       /* Internal, spin loops per bit */
+
+    uint32_t HalfBitLoops;   /* Internal, spin loops per half bit */
+
+    uint32_t Hclk;           /* Internal, HCLK the loop counts were computed for */
+} BITBANG_UartTypeDef;
+/* Exported constants --------------------------------------------------------*/
+/* WS2812 latch (reset) time, 280us covers the WS2812B-V5 and later */
+#ifndef HAL_BITBANG_WS2812_LATCH_US
+#define HAL_BITBANG_WS2812_LATCH_US    280U
+#endif
+/* Exported functions --------------------------------------------------------*/
+HAL_StatusTypeDef HAL_BITBANG_Init(void);
+HAL_StatusTypeDef HAL_BITBANG_WS2812_Write(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_BITBANG_OW_Reset(const BITBANG_OneWireTypeDef *how);
+HAL_StatusTypeDef HAL_BITBANG_OW_Write(const BITBANG_OneWireTypeDef *how, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_BITBANG_OW_Read(const BITBANG_OneWireTypeDef *how, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_BITBANG_UART_Init(BITBANG_UartTypeDef *hsu);
+HAL_StatusTypeDef HAL_BITBANG_UART_Transmit(const BITBANG_UartTypeDef *hsu, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_BITBANG_UART_Receive(const BITBANG_UartTypeDef *hsu, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+/* Exported inline functions -------------------------------------------------*/
+/**
+  * @brief  Spin for a number of loop iterations (one addi + one taken branch each).
+  * @param  Loops iteration count, at least 1.
+  * @retval None
+  */
+static inline void HAL_BITBANG_Spin(uint32_t Loops)
+{
+    __asm volatile ("1: addi %0, %0, -1\n\t"
+                    "   bnez %0, 1b"
+                    : "+r"(Loops) :: );
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CH32V00X_HAL_BITBANG_H */
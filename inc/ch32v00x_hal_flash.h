@@ -176,7 +176,11 @@ typedef struct
   } while (0)
 /* Exported functions --------------------------------------------------------*/
 HAL_StatusTypeDef HAL_FLASH_Program(FLASH_HandleTypeDef* hflash, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASH_Program_Us(FLASH_HandleTypeDef* hflash, uint64_t Data, uint32_t TimeoutUs);
 HAL_StatusTypeDef HAL_FLASH_Erase(FLASH_HandleTypeDef* hflash);
+HAL_StatusTypeDef HAL_FLASH_Erase_Us(FLASH_HandleTypeDef* hflash, uint32_t TimeoutUs);
+HAL_StatusTypeDef HAL_FLASH_Erase_Start(FLASH_HandleTypeDef* hflash);
+HAL_StatusTypeDef HAL_FLASH_Finish(FLASH_HandleTypeDef* hflash);
 HAL_StatusTypeDef HAL_FLASH_Unlock(FLASH_HandleTypeDef* hflash);
 HAL_StatusTypeDef HAL_FLASH_Lock(FLASH_HandleTypeDef* hflash);
 HAL_StatusTypeDef HAL_FLASH_SystemReset(FLASH_HandleTypeDef* hflash, uint32_t Mode);
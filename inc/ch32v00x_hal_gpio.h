@@ -55,6 +55,128 @@ typedef struct
     GPIOMode_TypeDef GPIO_Mode; /* Specifies the operating mode for the selected pins.
                                    This parameter can be a value of @ref GPIOMode_TypeDef */
 } GPIO_InitTypeDef;
+
+/* GPIO EXTI trigger edges */
+typedef enum
+{
+    GPIO_EXTI_TRIGGER_NONE           = 0x00U,
+    GPIO_EXTI_TRIGGER_RISING         = 0x01U,
+    GPIO_EXTI_TRIGGER_FALLING        = 0x02U,
+    GPIO_EXTI_TRIGGER_RISING_FALLING = 0x03U
+} GPIO_EXTITriggerTypeDef;
+
+/* GPIO EXTI configuration of a group of lines */
+typedef struct
+{
+    uint16_t Lines;                 /* EXTI lines, any combination of GPIO_Pin_x where x can be (0..7)
+                                       and GPIO_EXTI_LINE_PVD / GPIO_EXTI_LINE_AWU */
+
+    uint8_t PortSource;             /* GPIO_PortSourceGPIOx routed to lines 0..7, unused for lines 8..9 */
+
+    uint8_t Trigger;                /* A value of @ref GPIO_EXTITriggerTypeDef */
+
+    uint8_t Mode;                   /* Any combination of @ref GPIO_EXTI_Mode, GPIO_EXTI_MODE_NONE masks the lines */
+} GPIO_EXTIConfigTypeDef;
+
+/* GPIO EXTI line callback, GPIO_Pin is the GPIO_Pin_x of the line */
+typedef void (*pGPIO_EXTICallbackTypeDef)(uint16_t GPIO_Pin, void *Context);
+
+/* GPIO change detector over a port snapshot */
+typedef struct
+{
+    uint32_t Mask;                  /* Snapshot bits watched, built with GPIO_SNAPSHOT_PINS */
+
+    uint32_t Last;                  /* Watched bits of the previous snapshot */
+} GPIO_ChangeDetectTypeDef;
+
+/* GPIO key matrix, rows driven low one at a time, columns read with pull-ups */
+typedef struct
+{
+    GPIO_TypeDef *RowPort;          /* Row port, pins configured as GPIO_Mode_Out_OD */
+
+    uint16_t RowPins;               /* Row pins, any combination of @ref GPIO_pins_define */
+
+    GPIO_TypeDef *ColPort;          /* Column port, pins configured as GPIO_Mode_IPU */
+
+    uint16_t ColPins;               /* Column pins, rows x columns must not exceed 32 */
+
+    uint16_t SettleUs;              /* Delay between driving a row and sampling, 0 for none */
+
+    uint32_t State;                 /* Keys pressed at the last scan, bit (row * columns + column) */
+} GPIO_KeypadTypeDef;
+
+/* GPIO alternate function remap of the whole chip */
+typedef struct
+{
+    uint8_t Usart1;                 /* USART1 pin set, GPIO_REMAP_USART1_0..3 */
+
+    uint8_t Spi1;                   /* SPI1 pin set, GPIO_REMAP_SPI1_0..1 */
+
+    uint8_t I2c1;                   /* I2C1 pin set, GPIO_REMAP_I2C1_0..2 */
+
+    uint8_t Tim1;                   /* TIM1 pin set, GPIO_REMAP_TIM1_0..3 */
+
+    uint8_t Tim2;                   /* TIM2 pin set, GPIO_REMAP_TIM2_0..3 */
+
+    uint8_t Osc;                    /* ENABLE: PA1/PA2 are the HSE crystal pins */
+
+    uint8_t SwdDisable;             /* ENABLE: SWD released, PD1 becomes a GPIO */
+
+    uint8_t AdcTrigger;             /* ADC external trigger inputs remapped, any combination of
+                                       GPIO_REMAP_ADC_ETRGINJ and GPIO_REMAP_ADC_ETRGREG.
+                                       The trigger pins are not part of the conflict check */
+
+    uint32_t Signals;               /* Signals actually routed to pins, any combination of @ref GPIO_AF_Signals.
+                                       Only these pins take part in the conflict check */
+} GPIO_RemapTypeDef;
+
+/* GPIO board pin table entry */
+typedef struct
+{
+    GPIO_TypeDef *Port;             /* GPIOx where x can be (A..D) */
+
+    uint16_t Pin;                   /* Pins sharing this configuration, any combination of @ref GPIO_pins_define */
+
+    GPIOMode_TypeDef Mode;          /* Operating mode, a value of @ref GPIOMode_TypeDef */
+
+    GPIOSpeed_TypeDef Speed;        /* Output speed, ignored for input modes */
+
+    GPIO_PinState Level;            /* Initial output level, ignored for input modes */
+} GPIO_PinConfigTypeDef;
+
+/* GPIO whole port configuration, merged from a pin table or built with HAL_GPIO_CFG_xxx */
+typedef struct
+{
+    GPIO_TypeDef *Port;             /* GPIOx where x can be (A..D) */
+
+    uint32_t CfgMask;               /* CFGLR nibbles owned by this configuration */
+
+    uint32_t CfgValue;              /* CFGLR value of the owned nibbles */
+
+    uint16_t OutMask;               /* OUTDR bits owned by this configuration */
+
+    uint16_t OutValue;              /* OUTDR value of the owned bits (output level or pull direction) */
+} GPIO_PortConfigTypeDef;
+
+/* GPIO parallel bus structure definition */
+typedef struct
+{
+    GPIO_TypeDef *DataPort;     /* Port carrying the data lines */
+
+    uint8_t DataShift;          /* Pin number of data bit 0, data lines are contiguous */
+
+    uint8_t DataWidth;          /* Number of data lines, 1..8 with DataShift + DataWidth <= 8 */
+
+    GPIO_TypeDef *StrobePort;   /* Port of the strobe (WR/RD/E) line */
+
+    uint16_t StrobePin;         /* Strobe pin, a value of @ref GPIO_pins_define */
+
+    GPIO_PinState StrobeActive; /* Strobe active level, GPIO_PIN_RESET for an active low strobe */
+
+    uint16_t SetupNs;           /* Minimum data setup time before the strobe active edge, ns */
+
+    uint16_t PulseNs;           /* Minimum strobe pulse width (write) or access time (read), ns */
+} GPIO_BusTypeDef;
 /* Exported constants --------------------------------------------------------*/
 /* GPIO_pins_define */
 #define GPIO_Pin_0                     ((uint16_t)0x0001) /* Pin 0 selected */
@@ -81,6 +203,64 @@ typedef struct
 #define GPIO_PinSource5                ((uint8_t)0x05)
 #define GPIO_PinSource6                ((uint8_t)0x06)
 #define GPIO_PinSource7                ((uint8_t)0x07)
+
+/* GPIO_Remap_Sets */
+#define GPIO_REMAP_USART1_0            ((uint8_t)0x00) /* CK/PD4, TX/PD5, RX/PD6, CTS/PD3, RTS/PC2 */
+#define GPIO_REMAP_USART1_1            ((uint8_t)0x01) /* CK/PD7, TX/PD0, RX/PD1, CTS/PC3, RTS/PC2 */
+#define GPIO_REMAP_USART1_2            ((uint8_t)0x02) /* CK/PD7, TX/PD6, RX/PD5, CTS/PC6, RTS/PC7 */
+#define GPIO_REMAP_USART1_3            ((uint8_t)0x03) /* CK/PC5, TX/PC0, RX/PC1, CTS/PC6, RTS/PC7 */
+#define GPIO_REMAP_SPI1_0              ((uint8_t)0x00) /* NSS/PC1, SCK/PC5, MISO/PC7, MOSI/PC6 */
+#define GPIO_REMAP_SPI1_1              ((uint8_t)0x01) /* NSS/PC0, SCK/PC5, MISO/PC7, MOSI/PC6 */
+#define GPIO_REMAP_I2C1_0              ((uint8_t)0x00) /* SCL/PC2, SDA/PC1 */
+#define GPIO_REMAP_I2C1_1              ((uint8_t)0x01) /* SCL/PD1, SDA/PD0 */
+#define GPIO_REMAP_I2C1_2              ((uint8_t)0x02) /* SCL/PC5, SDA/PC6 */
+#define GPIO_REMAP_TIM1_0              ((uint8_t)0x00) /* ETR/PC5, CH1-4/PD2,PA1,PC3,PC4, BKIN/PC2, CH1N-3N/PD0,PA2,PD1 */
+#define GPIO_REMAP_TIM1_1              ((uint8_t)0x01) /* ETR/PC5, CH1-4/PC6,PC7,PC0,PD3, BKIN/PC1, CH1N-3N/PC3,PC4,PD1 */
+#define GPIO_REMAP_TIM1_2              ((uint8_t)0x02) /* ETR/PD4, CH1-4/PD2,PA1,PC3,PC4, BKIN/PC2, CH1N-3N/PD0,PA2,PD1 */
+#define GPIO_REMAP_TIM1_3              ((uint8_t)0x03) /* ETR/PC2, CH1-4/PC4,PC7,PC5,PD4, BKIN/PC1, CH1N-3N/PC3,PD2,PC6 */
+#define GPIO_REMAP_TIM2_0              ((uint8_t)0x00) /* CH1/ETR/PD4, CH2/PD3, CH3/PC0, CH4/PD7 */
+#define GPIO_REMAP_TIM2_1              ((uint8_t)0x01) /* CH1/ETR/PC5, CH2/PC2, CH3/PD2, CH4/PC1 */
+#define GPIO_REMAP_TIM2_2              ((uint8_t)0x02) /* CH1/ETR/PC1, CH2/PD3, CH3/PC0, CH4/PD7 */
+#define GPIO_REMAP_TIM2_3              ((uint8_t)0x03) /* CH1/ETR/PC1, CH2/PC7, CH3/PD6, CH4/PD5 */
+#define GPIO_REMAP_ADC_ETRGINJ         ((uint8_t)0x01) /* Injected conversion external trigger remapped */
+#define GPIO_REMAP_ADC_ETRGREG         ((uint8_t)0x02) /* Regular conversion external trigger remapped */
+
+/* GPIO_AF_Signals */
+#define GPIO_AF_USART1_CK              ((uint32_t)0x00000001)
+#define GPIO_AF_USART1_TX              ((uint32_t)0x00000002)
+#define GPIO_AF_USART1_RX              ((uint32_t)0x00000004)
+#define GPIO_AF_USART1_CTS             ((uint32_t)0x00000008)
+#define GPIO_AF_USART1_RTS             ((uint32_t)0x00000010)
+#define GPIO_AF_SPI1_NSS               ((uint32_t)0x00000020)
+#define GPIO_AF_SPI1_SCK               ((uint32_t)0x00000040)
+#define GPIO_AF_SPI1_MISO              ((uint32_t)0x00000080)
+#define GPIO_AF_SPI1_MOSI              ((uint32_t)0x00000100)
+#define GPIO_AF_I2C1_SCL               ((uint32_t)0x00000200)
+#define GPIO_AF_I2C1_SDA               ((uint32_t)0x00000400)
+#define GPIO_AF_TIM1_ETR               ((uint32_t)0x00000800)
+#define GPIO_AF_TIM1_CH1               ((uint32_t)0x00001000)
+#define GPIO_AF_TIM1_CH2               ((uint32_t)0x00002000)
+#define GPIO_AF_TIM1_CH3               ((uint32_t)0x00004000)
+#define GPIO_AF_TIM1_CH4               ((uint32_t)0x00008000)
+#define GPIO_AF_TIM1_BKIN              ((uint32_t)0x00010000)
+#define GPIO_AF_TIM1_CH1N              ((uint32_t)0x00020000)
+#define GPIO_AF_TIM1_CH2N              ((uint32_t)0x00040000)
+#define GPIO_AF_TIM1_CH3N              ((uint32_t)0x00080000)
+#define GPIO_AF_TIM2_CH1               ((uint32_t)0x00100000)
+#define GPIO_AF_TIM2_CH2               ((uint32_t)0x00200000)
+#define GPIO_AF_TIM2_CH3               ((uint32_t)0x00400000)
+#define GPIO_AF_TIM2_CH4               ((uint32_t)0x00800000)
+#define GPIO_AF_MCO                    ((uint32_t)0x01000000) /* PC4, no remap */
+#define GPIO_AF_SIGNAL_COUNT           25U
+
+/* GPIO_EXTI_Lines (non GPIO) */
+#define GPIO_EXTI_LINE_PVD             ((uint16_t)0x0100) /* EXTI line 8, PVD output */
+#define GPIO_EXTI_LINE_AWU             ((uint16_t)0x0200) /* EXTI line 9, auto wake-up */
+
+/* GPIO_EXTI_Mode */
+#define GPIO_EXTI_MODE_NONE            ((uint8_t)0x00)    /* Line masked */
+#define GPIO_EXTI_MODE_IT              ((uint8_t)0x01)    /* Line raises its interrupt */
+#define GPIO_EXTI_MODE_EVT             ((uint8_t)0x02)    /* Line raises an event (wakes WFE) */
 /* Exported macro ------------------------------------------------------------*/
 /**
   * @brief  Checks whether the specified EXTI line is asserted or not.
@@ -97,16 +277,164 @@ typedef struct
   * @retval None
   */
 #define __HAL_GPIO_EXTI_CLEAR_IT(__EXTI_LINE__) (EXTI->INTFR = (__EXTI_LINE__))
+/**
+  * @brief  Compile-time helpers to build a GPIO_PortConfigTypeDef, e.g.
+  *           { GPIOD,
+  *             HAL_GPIO_CFG_MASK(0) | HAL_GPIO_CFG_MASK(4),
+  *             HAL_GPIO_CFG_PIN(0, GPIO_Mode_Out_PP, GPIO_Speed_2MHz) | HAL_GPIO_CFG_PIN(4, GPIO_Mode_IPU, 0),
+  *             GPIO_Pin_0 | GPIO_Pin_4,
+  *             GPIO_Pin_4 }
+  * @param  __PINSRC__ pin number (0..7).
+  * @param  __MODE__ a value of @ref GPIOMode_TypeDef.
+  * @param  __SPEED__ a value of @ref GPIOSpeed_TypeDef, ignored for input modes.
+  */
+#define HAL_GPIO_CFG_NIBBLE(__MODE__, __SPEED__)                                        \
+    ((((uint32_t)(__MODE__)) & 0x0FU) | (((((uint32_t)(__MODE__)) & 0x10U) != 0U) ? (uint32_t)(__SPEED__) : 0U))
+
+#define HAL_GPIO_CFG_PIN(__PINSRC__, __MODE__, __SPEED__)                               \
+    (HAL_GPIO_CFG_NIBBLE((__MODE__), (__SPEED__)) << ((__PINSRC__) * 4U))
+
+#define HAL_GPIO_CFG_MASK(__PINSRC__)   ((uint32_t)0x0FU << ((__PINSRC__) * 4U))
+/**
+  * @brief  Port source (GPIO_PortSourceGPIOx) of a GPIO port.
+  * @param  __GPIOx__ where x can be (A..D).
+  */
+#define GPIO_GET_PORT_SOURCE(__GPIOx__)                                 \
+    (((__GPIOx__) == GPIOA) ? GPIO_PortSourceGPIOA :                    \
+     ((__GPIOx__) == GPIOC) ? GPIO_PortSourceGPIOC : GPIO_PortSourceGPIOD)
+/**
+  * @brief  Position of pins in a HAL_GPIO_Snapshot() value: port A in bits 0..7,
+  *         port C in bits 16..23, port D in bits 24..31.
+  * @param  __PORTSRC__ GPIO_PortSourceGPIOx where x can be (A..D).
+  * @param  __PINS__ any combination of GPIO_Pin_x where x can be (0..7).
+  */
+#define GPIO_SNAPSHOT_PINS(__PORTSRC__, __PINS__)   ((uint32_t)((__PINS__) & 0xFFU) << ((__PORTSRC__) << 3))
 /* Exported functions --------------------------------------------------------*/
 void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
 GPIO_PinState HAL_GPIO_ReadInput(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
 GPIO_PinState HAL_GPIO_ReadOutput(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
 void HAL_GPIO_Write(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
 void HAL_GPIO_Toggle(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_InitTable(const GPIO_PinConfigTypeDef *Table, uint16_t Count);
+void HAL_GPIO_MergeTable(const GPIO_PinConfigTypeDef *Table, uint16_t Count,
+                         GPIO_PortConfigTypeDef *PortConfig, uint8_t *NbPorts);
+void HAL_GPIO_ApplyPortConfig(const GPIO_PortConfigTypeDef *PortConfig, uint8_t NbPorts);
+void HAL_GPIO_WritePort(GPIO_TypeDef *GPIOx, uint16_t Mask, uint16_t Value);
+uint16_t HAL_GPIO_ReadPort(GPIO_TypeDef *GPIOx);
+uint32_t HAL_GPIO_Snapshot(void);
+void HAL_GPIO_ChangeInit(GPIO_ChangeDetectTypeDef *hcd, uint32_t Mask);
+uint32_t HAL_GPIO_ChangeDetect(GPIO_ChangeDetectTypeDef *hcd, uint32_t *Snapshot);
+HAL_StatusTypeDef HAL_GPIO_KeypadInit(GPIO_KeypadTypeDef *hkp);
+uint32_t HAL_GPIO_KeypadScan(GPIO_KeypadTypeDef *hkp, uint32_t *Changed);
+void HAL_GPIO_BusWrite(const GPIO_BusTypeDef *hbus, uint8_t Data);
+void HAL_GPIO_BusWriteBuffer(const GPIO_BusTypeDef *hbus, const uint8_t *pData, uint16_t Size);
+uint8_t HAL_GPIO_BusRead(const GPIO_BusTypeDef *hbus);
+HAL_StatusTypeDef HAL_GPIO_RemapCheck(const GPIO_RemapTypeDef *Remap, uint32_t *Conflicts);
+HAL_StatusTypeDef HAL_GPIO_RemapConfig(const GPIO_RemapTypeDef *Remap);
 void HAL_GPIO_PinLockConfig(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
 void HAL_GPIO_EXTILineConfig(uint8_t GPIO_PortSource, uint8_t GPIO_PinSource);
+HAL_StatusTypeDef HAL_GPIO_EXTI_Config(const GPIO_EXTIConfigTypeDef *Config);
+void HAL_GPIO_EXTI_Enable(uint16_t Lines, uint8_t Mode);
+void HAL_GPIO_EXTI_Disable(uint16_t Lines, uint8_t Mode);
+void HAL_GPIO_EXTI_GenerateSWI(uint16_t Lines);
 void HAL_GPIO_EXTI_IRQHandler(uint16_t GPIO_Pin);
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+HAL_StatusTypeDef HAL_GPIO_EXTI_RegisterCallback(uint8_t GPIO_PinSource, pGPIO_EXTICallbackTypeDef pCallback, void *Context);
+HAL_StatusTypeDef HAL_GPIO_EXTI_UnregisterCallback(uint8_t GPIO_PinSource);
+void HAL_GPIO_EXTI_Dispatch(void);
+/* Exported inline functions -------------------------------------------------*/
+/*
+ * Fast path: no parameter check, a single BSHR/BCR store or INDR load once
+ * inlined with constant arguments. A pin can be described once and passed
+ * as a whole:
+ *
+ *   #define LED_PIN   HAL_GPIO_PIN_DESC(GPIOD, GPIO_Pin_0)
+ *   HAL_GPIO_FastToggle(LED_PIN);
+ */
+#define HAL_GPIO_PIN_DESC(__PORT__, __PIN__)   (__PORT__), (__PIN__)
+
+/**
+  * @brief  Set the selected pins (one BSHR store).
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_Pin any combination of GPIO_Pin_x where x can be (0..7).
+  * @retval None
+  */
+static inline void HAL_GPIO_FastSet(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->BSHR = (uint32_t)GPIO_Pin;
+}
+
+/**
+  * @brief  Clear the selected pins (one BCR store).
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_Pin any combination of GPIO_Pin_x where x can be (0..7).
+  * @retval None
+  */
+static inline void HAL_GPIO_FastReset(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->BCR = (uint32_t)GPIO_Pin;
+}
+
+/**
+  * @brief  Set or clear the selected pins (one BSHR store, set or reset half).
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_Pin any combination of GPIO_Pin_x where x can be (0..7).
+  * @param  PinState GPIO_PIN_RESET or GPIO_PIN_SET.
+  * @retval None
+  */
+static inline void HAL_GPIO_FastWrite(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    GPIOx->BSHR = (uint32_t)GPIO_Pin << ((PinState != GPIO_PIN_RESET) ? 0U : 16U);
+}
+
+/**
+  * @brief  Read the selected input pin (one INDR load).
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_Pin GPIO_Pin_x where x can be (0..7).
+  * @retval The input port pin value.
+  */
+static inline GPIO_PinState HAL_GPIO_FastRead(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return ((GPIOx->INDR & (uint32_t)GPIO_Pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/**
+  * @brief  Toggle the selected pins without branching: pins currently high go
+  *         to the reset half of BSHR, pins currently low to the set half.
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_Pin any combination of GPIO_Pin_x where x can be (0..7).
+  * @retval None
+  */
+static inline void HAL_GPIO_FastToggle(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    uint32_t odr = GPIOx->OUTDR;
+
+    GPIOx->BSHR = ((odr & (uint32_t)GPIO_Pin) << 16U) | (~odr & (uint32_t)GPIO_Pin);
+}
+
+/**
+  * @brief  Drive the pins selected by Mask to the matching bits of Value in
+  *         one BSHR store (set in the low half, reset in the high half).
+  * @param  GPIOx where x can be (A..D).
+  * @param  Mask pins to update, any combination of GPIO_Pin_x where x can be (0..7).
+  * @param  Value new level of the pins, bits outside Mask are ignored.
+  * @retval None
+  */
+static inline void HAL_GPIO_FastWritePort(GPIO_TypeDef *GPIOx, uint16_t Mask, uint16_t Value)
+{
+    GPIOx->BSHR = (((uint32_t)~Value & Mask) << 16U) | ((uint32_t)Value & Mask);
+}
+
+/**
+  * @brief  Read the whole input port (one INDR load).
+  * @param  GPIOx where x can be (A..D).
+  * @retval Input level of pins 0..7.
+  */
+static inline uint16_t HAL_GPIO_FastReadPort(GPIO_TypeDef *GPIOx)
+{
+    return (uint16_t)(GPIOx->INDR & 0x00FFU);
+}
 /* Private macros ------------------------------------------------------------*/
 /* GPIO check port */
 #define IS_GPIO_INSTANCE(INSTANCE) ( \
@@ -149,6 +477,40 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
     ((MODE) == GPIO_Mode_IPD)  || \
     ((MODE) == GPIO_Mode_IPU)  )
 
+/* GPIO check pin mask (any combination of pins 0..7) */
+#define IS_GPIO_PIN_MASK(MASK)   ( ((MASK) & (uint16_t)0xFF00U) == 0U )
+
+/* GPIO check remap sets */
+#define IS_GPIO_REMAP(REMAP) ( \
+    ((REMAP)->Usart1 <= GPIO_REMAP_USART1_3) && \
+    ((REMAP)->Spi1 <= GPIO_REMAP_SPI1_1)     && \
+    ((REMAP)->I2c1 <= GPIO_REMAP_I2C1_2)     && \
+    ((REMAP)->Tim1 <= GPIO_REMAP_TIM1_3)     && \
+    ((REMAP)->Tim2 <= GPIO_REMAP_TIM2_3)     && \
+    (((REMAP)->AdcTrigger & ~(GPIO_REMAP_ADC_ETRGINJ | GPIO_REMAP_ADC_ETRGREG)) == 0U) )
+
+/* GPIO check EXTI lines (0..9) */
+#define IS_GPIO_EXTI_LINES(LINES)   ( ((LINES) != 0U) && (((LINES) & (uint16_t)0xFC00U) == 0U) )
+
+/* GPIO check EXTI trigger */
+#define IS_GPIO_EXTI_TRIGGER(TRIG)  ( (TRIG) <= GPIO_EXTI_TRIGGER_RISING_FALLING )
+
+/* GPIO check EXTI mode */
+#define IS_GPIO_EXTI_MODE(MODE)     ( ((MODE) & (uint8_t)~(GPIO_EXTI_MODE_IT | GPIO_EXTI_MODE_EVT)) == 0U )
+
+/* GPIO EXTI lines 0..7 served by EXTI7_0_IRQn */
+#define GPIO_EXTI_LINES_MASK         0x00FFU
+
+/* GPIO number of ports (A, C, D) */
+#define GPIO_PORT_COUNT              3U
+
+/* GPIO check parallel bus geometry */
+#define IS_GPIO_BUS(SHIFT, WIDTH)   ( ((WIDTH) >= 1U) && (((SHIFT) + (WIDTH)) <= 8U) )
+
+/* GPIO check bus strobe, outside the data lines when it shares their port */
+#define IS_GPIO_BUS_STROBE(BUS)     ( ((BUS)->DataPort != (BUS)->StrobePort) || \
+    (((uint32_t)(BUS)->StrobePin & ((((1UL << (BUS)->DataWidth) - 1UL)) << (BUS)->DataShift)) == 0U) )
+
 /* GPIO check HIGH/LOW pin state */
 #define IS_GPIO_PIN_STATE(LVL)   ( (LVL) == GPIO_PIN_RESET || (LVL) == GPIO_PIN_SET )
 
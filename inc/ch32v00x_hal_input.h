@@ -0,0 +1,78 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : ch32v00x_hal_input.h
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : Header file of the EXTI driven input engine (debounced
+ *                      buttons, quadrature encoders, event queue)
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+#ifndef __CH32V00X_HAL_INPUT_H
+#define __CH32V00X_HAL_INPUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Edges are caught by EXTI and stamped with HAL_GetCycles(), a tick task
+ * closes the debounce windows and posts events, the application only pops
+ * the queue. EXTI lines 0..7 must be served by HAL_GPIO_EXTI_Dispatch().
+ *
+ *   HAL_INPUT_Init();
+ *   HAL_INPUT_ConfigButton(GPIOC, GPIO_PinSource3, 5000U);
+ *   HAL_INPUT_ConfigEncoder(GPIOD, GPIO_PinSource2, GPIOD, GPIO_PinSource3, 4U);
+ *
+ *   while (HAL_INPUT_GetEvent(&evt) != FALSE) { ... }
+ */
+
+/* Exported types ------------------------------------------------------------*/
+/* Input event identifiers */
+typedef enum
+{
+    HAL_INPUT_EVT_RISING  = 0x00U,  /*!< Debounced level went high, Value = 1          */
+    HAL_INPUT_EVT_FALLING = 0x01U,  /*!< Debounced level went low, Value = 0           */
+    HAL_INPUT_EVT_ENCODER = 0x02U   /*!< Encoder moved one detent, Value = +1 or -1    */
+} HAL_INPUT_EventIdTypeDef;
+
+/* Input event (8 bytes) */
+typedef struct
+{
+    uint32_t Timestamp;  /* HAL_GetCycles() of the edge that started the transition */
+
+    uint8_t  Line;       /* EXTI line, encoder events report their A line */
+
+    uint8_t  Id;         /* HAL_INPUT_EventIdTypeDef */
+
+    int8_t   Value;      /* New level, or encoder direction */
+
+    uint8_t  Reserved;
+} INPUT_EventTypeDef;
+/* Exported constants --------------------------------------------------------*/
+/* Event queue depth, must be a power of 2 */
+#ifndef HAL_INPUT_QUEUE_SIZE
+#define HAL_INPUT_QUEUE_SIZE           16U
+#endif
+/* Exported functions --------------------------------------------------------*/
+HAL_StatusTypeDef HAL_INPUT_Init(void);
+HAL_StatusTypeDef HAL_INPUT_DeInit(void);
+HAL_StatusTypeDef HAL_INPUT_ConfigButton(GPIO_TypeDef *GPIOx, uint8_t GPIO_PinSource, uint32_t DebounceUs);
+HAL_StatusTypeDef HAL_INPUT_ConfigEncoder(GPIO_TypeDef *GPIOx_A, uint8_t GPIO_PinSource_A,
+                                          GPIO_TypeDef *GPIOx_B, uint8_t GPIO_PinSource_B,
+                                          uint8_t StepsPerDetent);
+HAL_StatusTypeDef HAL_INPUT_Release(uint8_t GPIO_PinSource);
+uint8_t HAL_INPUT_GetEvent(INPUT_EventTypeDef *Event);
+uint32_t HAL_INPUT_GetDropped(void);
+/* Private macros ------------------------------------------------------------*/
+/* Input check steps per encoder detent */
+#define IS_INPUT_DETENT(STEPS) ( \
+    ((STEPS) == 1U) || \
+    ((STEPS) == 2U) || \
+    ((STEPS) == 4U) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CH32V00X_HAL_INPUT_H */
@@ -32,12 +32,33 @@ typedef struct
     uint8_t NVIC_IRQChannelSubPriority;
     FunctionalState NVIC_IRQChannelCmd;
 } NVIC_InitTypeDef;
+
+/* Registered interrupt handler, called from the dispatcher with its context */
+typedef void (*NVIC_HandlerTypeDef)(void *Context);
+
+/* ISR duration statistics, HCLK cycles */
+typedef struct
+{
+    uint32_t Count;          /* Entries */
+
+    uint32_t MinCycles;      /* Shortest duration */
+
+    uint32_t MaxCycles;      /* Longest duration */
+
+    uint32_t AvgCycles;      /* Mean duration, computed by HAL_NVIC_GetIsrStats() */
+
+    uint64_t TotalCycles;    /* Sum of the durations */
+} NVIC_IsrStatsTypeDef;
+
+/* ISR statistics dump callback, called once per traced interrupt */
+typedef void (*NVIC_IsrDumpTypeDef)(IRQn_Type IRQn, const NVIC_IsrStatsTypeDef *pStats, void *Context);
 /* Exported constants --------------------------------------------------------*/
 /* CSR_INTSYSCR_INEST_definition */
 #define INTSYSCR_INEST_NoEN   0x00   /* interrupt nesting disable(CSR-0x804 bit1 = 0) */
 #define INTSYSCR_INEST_EN     0x01   /* interrupt nesting enable(CSR-0x804 bit1 = 1) */
 
-/* Check the configuration of CSR(0x804) in the startup file(.S)
+/* Check the configuration of CSR(0x804) in the startup file(.S),
+*  HAL_NVIC_PriorityGroupConfig() changes it at run time
 *   interrupt nesting enable(CSR-0x804 bit1 = 1)
 *     priority - bit[7] - Preemption Priority
 *                bit[6] - Sub priority
@@ -52,14 +73,74 @@ typedef struct
 #endif
 
 /* Preemption_Priority_Group */
-#define NVIC_PriorityGroup_0           ((uint32_t)0x00) /* interrupt nesting enable(CSR-0x804 bit1 = 1) */
-#define NVIC_PriorityGroup_1           ((uint32_t)0x01) /* interrupt nesting disable(CSR-0x804 bit1 = 0) */
+#define NVIC_PriorityGroup_0           ((uint32_t)0x00) /* interrupt nesting disable(CSR-0x804 bit1 = 0) */
+#define NVIC_PriorityGroup_1           ((uint32_t)0x01) /* interrupt nesting enable(CSR-0x804 bit1 = 1) */
+
+/* CSR_INTSYSCR bits */
+#define NVIC_INTSYSCR_HWSTKEN          ((uint32_t)0x01) /* hardware prologue/epilogue (HPE) */
+#define NVIC_INTSYSCR_INESTEN          ((uint32_t)0x02) /* interrupt nesting */
+
+/* Vector table free (VTF) channels, the PFIC jumps to their address without a table fetch */
+#define NVIC_VTF_CHANNELS              2U
+
+/* Interrupt service routine attribute.
+ * With HPE the hardware stacks the caller-saved registers and the compiler
+ * emits no prologue. Define HAL_NVIC_NO_HPE if the startup code leaves HPE
+ * off: the HAL ISRs then save their registers in software. */
+#ifndef HAL_NVIC_NO_HPE
+#define HAL_IRQ_FAST                   __attribute__((interrupt("WCH-Interrupt-fast")))
+#else
+#define HAL_IRQ_FAST                   __attribute__((interrupt))
+#endif
+
+/* Vector table entries, exceptions included (TIM2 is the last IRQ) */
+#define HAL_NVIC_VECTOR_COUNT          ((uint32_t)TIM2_IRQn + 1U)
+
+/* Alignment of the RAM vector table base written to mtvec, conservative
+ * default, lower it to save RAM if the core in use documents a smaller one */
+#ifndef HAL_NVIC_VECTOR_ALIGN
+#define HAL_NVIC_VECTOR_ALIGN          1024
+#endif
+
+/* Interrupts traced with HAL_USE_ISR_TRACE, the first ones to run get a slot */
+#ifndef HAL_ISR_TRACE_SLOTS
+#define HAL_ISR_TRACE_SLOTS            8U
+#endif
 /* Exported functions --------------------------------------------------------*/
 void HAL_NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup);
+uint32_t HAL_NVIC_GetPriorityGroup(void);
+HAL_StatusTypeDef HAL_NVIC_ConfigHPE(FunctionalState NewState);
 void HAL_NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct);
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_GetPriority(IRQn_Type IRQn, uint32_t *pPreemptPriority, uint32_t *pSubPriority);
+HAL_StatusTypeDef HAL_NVIC_ConfigFastIRQ(uint32_t Channel, IRQn_Type IRQn, void (*Isr)(void));
 void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
 void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
 void HAL_NVIC_SystemReset(void);
+#ifdef HAL_NVIC_USE_RAM_VECTORS
+HAL_StatusTypeDef HAL_NVIC_InitVectors(void);
+HAL_StatusTypeDef HAL_NVIC_RegisterHandler(IRQn_Type IRQn, NVIC_HandlerTypeDef Handler, void *Context);
+HAL_StatusTypeDef HAL_NVIC_SetVector(IRQn_Type IRQn, void (*Isr)(void));
+#endif /* HAL_NVIC_USE_RAM_VECTORS */
+#ifdef HAL_USE_ISR_TRACE
+void HAL_NVIC_IsrTraceRecord(IRQn_Type IRQn, uint32_t Start);
+HAL_StatusTypeDef HAL_NVIC_GetIsrStats(IRQn_Type IRQn, NVIC_IsrStatsTypeDef *pStats);
+void HAL_NVIC_ResetIsrStats(void);
+void HAL_NVIC_DumpIsrStats(NVIC_IsrDumpTypeDef Callback, void *Context);
+#endif /* HAL_USE_ISR_TRACE */
+
+/* ISR entry/exit stamps, compiled out without HAL_USE_ISR_TRACE.
+ * Both go in the same block, the exit stamp must be reached on every path.
+ * They belong in vector entry points only, so each interrupt is traced once:
+ * the HAL vectors and the RAM vector dispatcher have them, a user vector
+ * calling a HAL handler (HAL_UART_IRQHandler(), ...) adds its own. */
+#ifdef HAL_USE_ISR_TRACE
+#define HAL_ISR_ENTER(IRQN)              uint32_t isr_trace_start = HAL_GetCycles()
+#define HAL_ISR_EXIT(IRQN)               HAL_NVIC_IsrTraceRecord((IRQN), isr_trace_start)
+#else
+#define HAL_ISR_ENTER(IRQN)              ((void)0U)
+#define HAL_ISR_EXIT(IRQN)               ((void)0U)
+#endif /* HAL_USE_ISR_TRACE */
 /* Private macros ------------------------------------------------------------*/
 /* NVIC check priority group */
 #define IS_NVIC_PRI_GROUP(PRI_GROUP) ( \
@@ -69,13 +150,20 @@ void HAL_NVIC_SystemReset(void);
 /* NVIC check valid IRQ channel */
 #define IS_NVIC_IRQ_CHANNEL(IRQ)                ((IRQ) >= (IRQn_Type)0x00U)
 
-/* NVIC check pre-empt priority */
-#define IS_NVIC_PREEMPTION_PRIORITY(PRIO)   \
-    ( ((INTSYSCR_INEST == INTSYSCR_INEST_NoEN) ? ((PRIO) == 0U) : ((PRIO) <= 1U)) )
+/* NVIC check vector table slot, NMI and above */
+#define IS_NVIC_VECTOR(IRQ)                 \
+    ( ((uint32_t)(IRQ) >= (uint32_t)NonMaskableInt_IRQn) && ((uint32_t)(IRQ) < HAL_NVIC_VECTOR_COUNT) )
+
+/* NVIC check pre-empt priority for the priority group in use */
+#define IS_NVIC_PREEMPTION_PRIORITY(GROUP, PRIO)   \
+    ( ((GROUP) == NVIC_PriorityGroup_0) ? ((PRIO) == 0U) : ((PRIO) <= 1U) )
+
+/* NVIC check sub priority for the priority group in use */
+#define IS_NVIC_SUB_PRIORITY(GROUP, PRIO)          \
+    ( ((GROUP) == NVIC_PriorityGroup_0) ? ((PRIO) <= 3U) : ((PRIO) <= 1U) )
 
-/* NVIC check sub priority */
-#define IS_NVIC_SUB_PRIORITY(PRIO)          \
-    ( ((INTSYSCR_INEST == INTSYSCR_INEST_NoEN) ? ((PRIO) <= 3U) : ((PRIO) <= 1U)) )
+/* NVIC check VTF channel */
+#define IS_NVIC_VTF_CHANNEL(CHANNEL)        ((CHANNEL) < NVIC_VTF_CHANNELS)
 
 /* NVIC check channel command */
 #define IS_NVIC_CHANNEL_CMD(CMD) ( \
@@ -0,0 +1,37 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : ch32v00x_hal_pwr.h
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : Header file of PWR HAL module
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+#ifndef __CH32V00X_HAL_PWR_H
+#define __CH32V00X_HAL_PWR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+/* PWR_Entry */
+#define PWR_ENTRY_WFI                  ((uint8_t)0x01) /* Wake on an interrupt */
+#define PWR_ENTRY_WFE                  ((uint8_t)0x02) /* Wake on an event, no interrupt is taken */
+/* Exported functions --------------------------------------------------------*/
+HAL_StatusTypeDef HAL_PWR_EnableWakeupPins(GPIO_TypeDef *GPIOx, uint16_t Pins, uint8_t Trigger, uint8_t Entry);
+void HAL_PWR_DisableWakeupPins(uint16_t Pins);
+void HAL_PWR_EnterSLEEPMode(uint8_t Entry);
+HAL_StatusTypeDef HAL_PWR_EnterSTANDBYMode(uint8_t Entry);
+uint32_t HAL_PWR_GetWakeupTimeUs(void);
+/* Private macros ------------------------------------------------------------*/
+/* PWR check entry */
+#define IS_PWR_ENTRY(ENTRY) ( \
+    ((ENTRY) == PWR_ENTRY_WFI) || \
+    ((ENTRY) == PWR_ENTRY_WFE) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CH32V00X_HAL_PWR_H */
@@ -24,10 +24,108 @@ typedef struct
     uint32_t PCLK2_Frequency;  /* returns PCLK2 clock frequency expressed in Hz */
     uint32_t ADCCLK_Frequency; /* returns ADCCLK clock frequency expressed in Hz */
 } RCC_ClocksTypeDef;
+
+/* RCC oscillators configuration */
+typedef struct
+{
+    uint32_t OscillatorType;       /* Oscillators to configure, any combination of @ref RCC_Oscillator_Type */
+
+    uint32_t HSEState;             /* RCC_HSE_OFF, RCC_HSE_ON or RCC_HSE_Bypass */
+
+    uint32_t HSIState;             /* RCC_HSI_OFF or RCC_HSI_ON */
+
+    uint8_t  HSICalibrationValue;  /* HSI trimming value, 0..0x1F */
+
+    uint32_t PLLState;             /* RCC_PLL_NONE, RCC_PLL_OFF or RCC_PLL_ON */
+
+    uint32_t PLLSource;            /* RCC_PLLSource_HSI_MUL2 or RCC_PLLSource_HSE_MUL2, used with RCC_PLL_ON */
+} RCC_OscInitTypeDef;
+
+/* RCC system clock configuration */
+typedef struct
+{
+    uint32_t SYSCLKSource;         /* A value of @ref System_clock_source */
+
+    uint32_t AHBCLKDivider;        /* A value of @ref AHB_clock_source */
+} RCC_ClkInitTypeDef;
+
+/* Boot phases timed by the boot profiler */
+typedef enum
+{
+    RCC_BOOT_PHASE_CLOCK = 0x00U,  /*!< HAL_RCC_OscConfig() / HAL_RCC_ClockConfig() */
+    RCC_BOOT_PHASE_TICK,           /*!< HAL_TickInit()                              */
+    RCC_BOOT_PHASE_GPIO,           /*!< HAL_GPIO_Init() / HAL_GPIO_InitTable()       */
+    RCC_BOOT_PHASE_UART,           /*!< HAL_UART_Init()                             */
+    RCC_BOOT_PHASE_FLASH,          /*!< HAL_FLASH_Unlock() to HAL_FLASH_Lock()      */
+    RCC_BOOT_PHASE_USER,           /*!< Application, HAL_BOOT_PHASE_BEGIN/END       */
+    RCC_BOOT_PHASE_COUNT
+} RCC_BootPhaseTypeDef;
+
+/* Boot report */
+typedef struct
+{
+    uint32_t ResetFlags;                         /* Reset cause, @ref RCC_Reset_Flags */
+
+    uint32_t PhaseCycles[RCC_BOOT_PHASE_COUNT];  /* HCLK cycles spent in each phase, calls accumulated */
+
+    uint32_t TotalCycles;                        /* HCLK cycles from HAL_RCC_BootProfileStart() to HAL_RCC_BootProfileEnd() */
+} RCC_BootReportTypeDef;
+
+/* Clock change callback, called with interrupts masked once the new clocks are active */
+typedef void (*pRCC_ClockChangeCallbackTypeDef)(const RCC_ClocksTypeDef *RCC_Clocks, void *Context);
+
+/* Clock change notifier, storage is provided by the caller and must stay valid while registered */
+typedef struct __RCC_ClockNotifierTypeDef
+{
+    pRCC_ClockChangeCallbackTypeDef   Callback;   /* Function called after a clock change */
+
+    void                              *Context;   /* User pointer passed back to Callback */
+
+    struct __RCC_ClockNotifierTypeDef *Next;      /* Internal chaining, do not modify */
+} RCC_ClockNotifierTypeDef;
 /* Exported constants --------------------------------------------------------*/
 /* MCO Index */
 #define RCC_MCO1                         ((uint32_t)0x00000000)
 
+/* RCC_Oscillator_Type */
+#define RCC_OSCILLATORTYPE_NONE          ((uint32_t)0x00000000)
+#define RCC_OSCILLATORTYPE_HSE           ((uint32_t)0x00000001)
+#define RCC_OSCILLATORTYPE_HSI           ((uint32_t)0x00000002)
+
+/* HSI_configuration */
+#define RCC_HSI_OFF                      ((uint32_t)0x00000000)
+#define RCC_HSI_ON                       ((uint32_t)0x00000001)
+
+/* PLL_configuration */
+#define RCC_PLL_NONE                     ((uint32_t)0x00000000) /* PLL left untouched */
+#define RCC_PLL_OFF                      ((uint32_t)0x00000001)
+#define RCC_PLL_ON                       ((uint32_t)0x00000002)
+
+/* Oscillator and clock switch timeout, in polling loops, used while SysTick is stopped */
+#ifndef HAL_RCC_STARTUP_TIMEOUT
+#define HAL_RCC_STARTUP_TIMEOUT          ((uint32_t)0x4000)
+#endif
+
+/* Oscillator and clock switch timeout, in microseconds, used once SysTick runs */
+#ifndef HAL_RCC_STARTUP_TIMEOUT_US
+#define HAL_RCC_STARTUP_TIMEOUT_US       ((uint32_t)5000)
+#endif
+
+/* RCC_Clock_Profile */
+#define RCC_PROFILE_PLL_48MHZ            ((uint32_t)0x00000000) /* HSI x2 PLL, 1 flash wait state */
+#define RCC_PROFILE_HSI_24MHZ            ((uint32_t)0x00000001) /* HSI, PLL stopped */
+#define RCC_PROFILE_HSI_8MHZ             ((uint32_t)0x00000002) /* HSI / 3, PLL stopped */
+#define RCC_PROFILE_HSI_1500KHZ          ((uint32_t)0x00000003) /* HSI / 16, PLL stopped */
+#define RCC_PROFILE_COUNT                4U
+
+/* HSI auto-trim: largest residual error accepted, in ppm of the nominal frequency */
+#ifndef HAL_RCC_HSI_TRIM_MAX_PPM
+#define HAL_RCC_HSI_TRIM_MAX_PPM         10000
+#endif
+
+/* Highest HCLK frequency running from flash without wait state */
+#define RCC_FLASH_LATENCY0_MAX_HZ        24000000U
+
 /* HSE_configuration */
 #define RCC_HSE_OFF                      ((uint32_t)0x00000000)
 #define RCC_HSE_ON                       ((uint32_t)0x00010000)
@@ -117,12 +215,29 @@ typedef struct
 #define RCC_FLAG_WWDGRST                 ((uint8_t)0x7E)
 #define RCC_FLAG_LPWRRST                 ((uint8_t)0x7F)
 
+/* RCC_Reset_Flags */
+#define RCC_RESET_PIN                    ((uint32_t)0x04000000) /* NRST pin */
+#define RCC_RESET_POR                    ((uint32_t)0x08000000) /* Power-on / power-down */
+#define RCC_RESET_SFT                    ((uint32_t)0x10000000) /* Software reset */
+#define RCC_RESET_IWDG                   ((uint32_t)0x20000000) /* Independent watchdog */
+#define RCC_RESET_WWDG                   ((uint32_t)0x40000000) /* Window watchdog */
+#define RCC_RESET_LPWR                   ((uint32_t)0x80000000) /* Low-power management */
+#define RCC_RESET_ALL                    ((uint32_t)0xFC000000)
+
 /* SysTick_clock_source */
 #define SysTick_CLKSource_HCLK_Div8      ((uint32_t)0xFFFFFFFB)
 #define SysTick_CLKSource_HCLK           ((uint32_t)0x00000004)
+/* Reference counted peripheral clocks */
+#define RCC_APB2Periph_REFCOUNTED        (RCC_APB2Periph_AFIO | RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOC | \
+                                          RCC_APB2Periph_GPIOD | RCC_APB2Periph_ADC1 | RCC_APB2Periph_TIM1 | \
+                                          RCC_APB2Periph_SPI1 | RCC_APB2Periph_USART1)
+#define RCC_APB1Periph_REFCOUNTED        (RCC_APB1Periph_TIM2 | RCC_APB1Periph_WWDG | RCC_APB1Periph_I2C1 | \
+                                          RCC_APB1Periph_PWR)
 /* Exported macro ------------------------------------------------------------*/
 /* ===========================================================
  * RCC clock macros for CH32V003 (APB2/APB1)
+ * Direct register access, they bypass the reference counts of
+ * HAL_RCC_ClockAcquire() / HAL_RCC_ClockRelease()
  * =========================================================== */
 
 /* ---------- APB2: ENABLE ---------- */
@@ -204,6 +319,13 @@ typedef struct
     UNUSED(tmpreg);                                                 \
 } while (0U)
 
+#define __HAL_RCC_PWR_CLK_ENABLE()     do {                         \
+    __IO uint32_t tmpreg = 0x00U;                                   \
+    SET_BIT(RCC->APB1PCENR, RCC_APB1Periph_PWR);                    \
+    tmpreg = READ_BIT(RCC->APB1PCENR, RCC_APB1Periph_PWR);          \
+    UNUSED(tmpreg);                                                 \
+} while (0U)
+
 /* ---------- APB2: DISABLE ---------- */
 #define __HAL_RCC_AFIO_CLK_DISABLE()   do {                         \
     CLEAR_BIT(RCC->APB2PCENR, RCC_APB2Periph_AFIO);                 \
@@ -249,10 +371,92 @@ typedef struct
 #define __HAL_RCC_I2C1_CLK_DISABLE()   do {                         \
     CLEAR_BIT(RCC->APB1PCENR, RCC_APB1Periph_I2C1);                 \
 } while (0U)
+
+#define __HAL_RCC_PWR_CLK_DISABLE()    do {                         \
+    CLEAR_BIT(RCC->APB1PCENR, RCC_APB1Periph_PWR);                  \
+} while (0U)
+/* Exported variables --------------------------------------------------------*/
+/* Clock tree cache, filled on first use and refreshed by HAL_RCC_ClockChanged(), read it through the getters below */
+extern RCC_ClocksTypeDef RCC_ClockTree;
 /* Exported functions --------------------------------------------------------*/
+HAL_StatusTypeDef HAL_RCC_OscConfig(const RCC_OscInitTypeDef *RCC_OscInit);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(const RCC_ClkInitTypeDef *RCC_ClkInit);
+HAL_StatusTypeDef HAL_RCC_SetProfile(uint32_t Profile);
+HAL_StatusTypeDef HAL_RCC_EnableCSS(uint32_t FallbackProfile);
+void HAL_RCC_DisableCSS(void);
+void HAL_RCC_CSS_IRQHandler(void);
+void HAL_RCC_CSS_Process(void);
+void HAL_RCC_CSSCallback(void);
+uint32_t HAL_RCC_GetCSSFailures(void);
 void HAL_RCC_GetClocksFreq(RCC_ClocksTypeDef *RCC_Clocks);
 void HAL_RCC_MCOConfig(uint32_t RCC_MCOx, uint32_t RCC_MCOSource);
 void HAL_RCC_AdjustHSICalibrationValue(uint8_t HSICalibrationValue);
+HAL_StatusTypeDef HAL_RCC_HSIAutoTrim(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint32_t RefHz, uint16_t Periods, int32_t *ErrorPpm);
+HAL_StatusTypeDef HAL_RCC_ClockAcquire(uint32_t APB2Periph, uint32_t APB1Periph);
+HAL_StatusTypeDef HAL_RCC_ClockRelease(uint32_t APB2Periph, uint32_t APB1Periph);
+uint32_t HAL_RCC_GetResetFlags(void);
+#ifdef HAL_USE_BOOT_PROFILE
+void HAL_RCC_BootProfileStart(void);
+void HAL_RCC_BootPhaseBegin(RCC_BootPhaseTypeDef Phase);
+void HAL_RCC_BootPhaseEnd(RCC_BootPhaseTypeDef Phase);
+void HAL_RCC_BootProfileEnd(void);
+const RCC_BootReportTypeDef *HAL_RCC_GetBootReport(void);
+#endif /* HAL_USE_BOOT_PROFILE */
+HAL_StatusTypeDef HAL_RCC_RegisterClockNotifier(RCC_ClockNotifierTypeDef *Notifier);
+HAL_StatusTypeDef HAL_RCC_UnregisterClockNotifier(RCC_ClockNotifierTypeDef *Notifier);
+void HAL_RCC_ClockChanged(void);
+void HAL_RCC_UpdateClockTree(void);
+/* Boot phase stamps, compiled out without HAL_USE_BOOT_PROFILE */
+#ifdef HAL_USE_BOOT_PROFILE
+#define HAL_BOOT_PHASE_BEGIN(PHASE)      HAL_RCC_BootPhaseBegin(PHASE)
+#define HAL_BOOT_PHASE_END(PHASE)        HAL_RCC_BootPhaseEnd(PHASE)
+#else
+#define HAL_BOOT_PHASE_BEGIN(PHASE)      ((void)0U)
+#define HAL_BOOT_PHASE_END(PHASE)        ((void)0U)
+#endif /* HAL_USE_BOOT_PROFILE */
+/* Exported inline functions -------------------------------------------------*/
+/*
+ * Cached lookups: a load and a compare, no register decoding and no division.
+ * The cache is filled on first use, so drivers initialized before
+ * HAL_TickInit() see the clock set up by the startup code, and then follows
+ * every change made through this module and HAL_RCC_ClockChanged(); code
+ * writing RCC->CFGR0 directly must call HAL_RCC_ClockChanged() afterwards.
+ */
+static inline const RCC_ClocksTypeDef *HAL_RCC_GetClockTree(void)
+{
+    /* HCLK is never zero once the cache has been filled */
+    if (RCC_ClockTree.HCLK_Frequency == 0U)
+    {
+        HAL_RCC_UpdateClockTree();
+    }
+
+    return &RCC_ClockTree;
+}
+
+static inline uint32_t HAL_RCC_GetSysClockFreq(void)
+{
+    return HAL_RCC_GetClockTree()->SYSCLK_Frequency;
+}
+
+static inline uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+    return HAL_RCC_GetClockTree()->HCLK_Frequency;
+}
+
+static inline uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return HAL_RCC_GetClockTree()->PCLK1_Frequency;
+}
+
+static inline uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+    return HAL_RCC_GetClockTree()->PCLK2_Frequency;
+}
+
+static inline uint32_t HAL_RCC_GetADCCLKFreq(void)
+{
+    return HAL_RCC_GetClockTree()->ADCCLK_Frequency;
+}
 /* Private macros ------------------------------------------------------------*/
 /* RCC check MCO instance */
 #define IS_RCC_MCO(MCO) ((MCO) == RCC_MCO1)
@@ -265,6 +469,56 @@ void HAL_RCC_AdjustHSICalibrationValue(uint8_t HSICalibrationValue);
     ((SOURCE) == RCC_MCO_HSE)     || \
     ((SOURCE) == RCC_MCO_PLLCLK) )
 
+/* RCC check reference counted peripheral clocks */
+#define IS_RCC_REFCOUNTED(APB2, APB1) ( \
+    (((APB2) & ~RCC_APB2Periph_REFCOUNTED) == 0U) && \
+    (((APB1) & ~RCC_APB1Periph_REFCOUNTED) == 0U) )
+
+/* RCC check clock profile */
+#define IS_RCC_PROFILE(PROFILE) ( (PROFILE) < RCC_PROFILE_COUNT )
+
+/* RCC check oscillator type */
+#define IS_RCC_OSCILLATORTYPE(TYPE) ( ((TYPE) & ~(RCC_OSCILLATORTYPE_HSE | RCC_OSCILLATORTYPE_HSI)) == 0U )
+
+/* RCC check HSE state */
+#define IS_RCC_HSE(HSE) ( \
+    ((HSE) == RCC_HSE_OFF) || \
+    ((HSE) == RCC_HSE_ON)  || \
+    ((HSE) == RCC_HSE_Bypass) )
+
+/* RCC check HSI state */
+#define IS_RCC_HSI(HSI) ( ((HSI) == RCC_HSI_OFF) || ((HSI) == RCC_HSI_ON) )
+
+/* RCC check HSI trimming value */
+#define IS_RCC_CALIBRATION_VALUE(VALUE) ( (VALUE) <= 0x1FU )
+
+/* RCC check PLL state */
+#define IS_RCC_PLL(PLL) ( \
+    ((PLL) == RCC_PLL_NONE) || \
+    ((PLL) == RCC_PLL_OFF)  || \
+    ((PLL) == RCC_PLL_ON) )
+
+/* RCC check PLL source */
+#define IS_RCC_PLLSOURCE(SOURCE) ( \
+    ((SOURCE) == RCC_PLLSource_HSI_MUL2) || \
+    ((SOURCE) == RCC_PLLSource_HSE_MUL2) )
+
+/* RCC check system clock source */
+#define IS_RCC_SYSCLKSOURCE(SOURCE) ( \
+    ((SOURCE) == RCC_SYSCLKSource_HSI) || \
+    ((SOURCE) == RCC_SYSCLKSource_HSE) || \
+    ((SOURCE) == RCC_SYSCLKSource_PLLCLK) )
+
+/* RCC check AHB prescaler */
+#define IS_RCC_HCLK(HCLK) ( \
+    ((HCLK) == RCC_SYSCLK_Div1)   || ((HCLK) == RCC_SYSCLK_Div2)   || \
+    ((HCLK) == RCC_SYSCLK_Div3)   || ((HCLK) == RCC_SYSCLK_Div4)   || \
+    ((HCLK) == RCC_SYSCLK_Div5)   || ((HCLK) == RCC_SYSCLK_Div6)   || \
+    ((HCLK) == RCC_SYSCLK_Div7)   || ((HCLK) == RCC_SYSCLK_Div8)   || \
+    ((HCLK) == RCC_SYSCLK_Div16)  || ((HCLK) == RCC_SYSCLK_Div32)  || \
+    ((HCLK) == RCC_SYSCLK_Div64)  || ((HCLK) == RCC_SYSCLK_Div128) || \
+    ((HCLK) == RCC_SYSCLK_Div256) )
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,11 +10,90 @@
 #ifndef __CH32V00X_HAL_TICK_H
 #define __CH32V00X_HAL_TICK_H
 
+/* Exported types ------------------------------------------------------------*/
+/* Tick period, value is the number of milliseconds added to the tick count per interrupt */
+typedef enum
+{
+    HAL_TICK_FREQ_10HZ    = 100U,
+    HAL_TICK_FREQ_100HZ   = 10U,
+    HAL_TICK_FREQ_1KHZ    = 1U
+} HAL_TickFreqTypeDef;
+
+/* Deadline time base */
+typedef enum
+{
+    HAL_DEADLINE_NEVER    = 0x00U,  /*!< Never expires (HAL_MAX_DELAY)      */
+    HAL_DEADLINE_MS       = 0x01U,  /*!< Start is a HAL_GetTick() value      */
+    HAL_DEADLINE_CYCLES   = 0x02U   /*!< Start is a HAL_GetCycles() value    */
+} HAL_DeadlineUnitTypeDef;
+
+/* Deadline, start time captured once when the wait starts */
+typedef struct
+{
+    uint32_t                Start;   /* Start time in Unit */
+
+    uint32_t                Timeout; /* Duration in Unit, compared to the unsigned elapsed time */
+
+    HAL_DeadlineUnitTypeDef Unit;    /* Time base of Start and Timeout */
+} HAL_DeadlineTypeDef;
+
+/* Span of HCLK cycles sampled on the SysTick counter, valid with interrupts masked */
+typedef struct
+{
+    uint32_t                Last;    /* Internal, CNT at the previous sample */
+
+    uint32_t                Elapsed; /* Cycles accumulated since the start */
+} HAL_TickSpanTypeDef;
+
+/* Periodic tick task callback, runs in SysTick interrupt context */
+typedef void (*pTICK_TaskCallbackTypeDef)(void *Context);
+
+/* Periodic tick task, storage is provided by the caller and must stay valid while registered */
+typedef struct __TICK_TaskTypeDef
+{
+    pTICK_TaskCallbackTypeDef Callback;    /* Function called every Period ticks */
+
+    void                      *Context;    /* User pointer passed back to Callback */
+
+    uint16_t                  Period;      /* Period in ticks, 1..65535 */
+
+    uint16_t                  Phase;       /* Offset in ticks inside the period, 0..Period-1.
+                                              Tasks sharing a period with different phases never
+                                              run on the same tick */
+
+    uint16_t                  Countdown;   /* Internal, ticks left before the next run */
+
+    uint16_t                  Overruns;    /* Runs longer than Period ticks (saturates) */
+
+    uint32_t                  MaxCycles;   /* Worst case execution time in HCLK cycles */
+
+    struct __TICK_TaskTypeDef *Next;       /* Internal chaining, do not modify */
+} TICK_TaskTypeDef;
 /* Exported functions --------------------------------------------------------*/
 void HAL_TickInit(void);
+HAL_StatusTypeDef HAL_SetTickFreq(HAL_TickFreqTypeDef Freq);
+HAL_TickFreqTypeDef HAL_GetTickFreq(void);
+void HAL_TickClockChanged(void);
 uint32_t HAL_GetTick(void);
 void HAL_Delay(uint32_t Delay);
 void HAL_DelayUs(uint32_t Delay);
+void HAL_DelayCycles(uint32_t Cycles);
+void HAL_TickSpanStart(HAL_TickSpanTypeDef *Span);
+uint32_t HAL_TickSpanElapsed(HAL_TickSpanTypeDef *Span);
 uint8_t HAL_TickExpired(uint32_t start_ms, uint32_t timeout_ms);
+uint32_t HAL_GetCycles(void);
+void HAL_DeadlineStart(HAL_DeadlineTypeDef *Deadline, uint32_t Timeout);
+void HAL_DeadlineStartCycles(HAL_DeadlineTypeDef *Deadline, uint32_t Cycles);
+void HAL_DeadlineStartUs(HAL_DeadlineTypeDef *Deadline, uint32_t TimeoutUs);
+uint8_t HAL_DeadlineExpired(const HAL_DeadlineTypeDef *Deadline);
+HAL_StatusTypeDef HAL_TickTaskRegister(TICK_TaskTypeDef *Task);
+HAL_StatusTypeDef HAL_TickTaskUnregister(TICK_TaskTypeDef *Task);
+uint32_t HAL_TickGetOverruns(void);
+/* Private macros ------------------------------------------------------------*/
+/* Tick check frequency */
+#define IS_TICK_FREQ(FREQ) ( \
+    ((FREQ) == HAL_TICK_FREQ_10HZ)  || \
+    ((FREQ) == HAL_TICK_FREQ_100HZ) || \
+    ((FREQ) == HAL_TICK_FREQ_1KHZ) )
 
 #endif /* __CH32V00X_HAL_TICK_H */
@@ -93,6 +93,9 @@ typedef struct __UART_HandleTypeDef
                                                         This parameter can be a value of @ref HAL_UART_StateTypeDef */
 
     __IO uint32_t                 ErrorCode;        /*!< UART Error code                    */
+
+    RCC_ClockNotifierTypeDef      ClockNotifier;    /*!< Internal, keeps BRR in step with the clock,
+                                                        registered by HAL_UART_Init() */
 } UART_HandleTypeDef;
 
 /* Exported constants --------------------------------------------------------*/
@@ -188,15 +191,20 @@ do { \
 
 /* Exported functions --------------------------------------------------------*/
 HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart);
 void HAL_UART_MspInit(UART_HandleTypeDef *huart);
+void HAL_UART_MspDeInit(UART_HandleTypeDef *huart);
 HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
 HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_Us(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t TimeoutUs);
+HAL_StatusTypeDef HAL_UART_Receive_Us(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t TimeoutUs);
 HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
 HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
 void HAL_UART_IRQHandler(UART_HandleTypeDef *huart);
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ClockChangeCallback(const RCC_ClocksTypeDef *RCC_Clocks, void *Context);
 /* Private macros ------------------------------------------------------------*/
 /* UART check instance (only USART1 available) */
 #define IS_UART_INSTANCE(INSTANCE) ((INSTANCE) == USART1)
@@ -0,0 +1,590 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : ch32v00x_hal_bitbang.c
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : Bit-bang protocol engines.
+ *                      This file provides WS2812, 1-Wire and software UART
+ *                      waveforms built on calibrated spin loops
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+/* Includes ------------------------------------------------------------------*/
+#include <ch32v00x_hal.h>
+/* Private typedef -----------------------------------------------------------*/
+/* Phase lengths converted to spin loops */
+typedef struct
+{
+    uint32_t Hclk;           /* HCLK the loop counts were computed for */
+
+    uint32_t LoopCycles16;   /* Measured cycles per spin loop, 4 fractional bits */
+
+    uint32_t Ws0H;           /* WS2812 phases */
+    uint32_t Ws0L;
+    uint32_t Ws1H;
+    uint32_t Ws1L;
+
+    uint32_t OwA;            /* 1-Wire standard speed segments, Maxim AN126 naming.
+                                A write '1' slot is run as a read slot (A + E + F = A + B) */
+    uint32_t OwC;
+    uint32_t OwD;
+    uint32_t OwE;
+    uint32_t OwF;
+} BITBANG_TimingTypeDef;
+/* Private define ------------------------------------------------------------*/
+#define BITBANG_CAL_LOOPS          256U     /* Loops timed by the calibration, cycles16 = delta >> 4 */
+
+/* Estimated fixed cost (cycles) around a spin, stores and loop control included.
+ * tools/bitbang_timing_model.c checks them against the instruction sequences */
+#define BITBANG_HIGH_OVERHEAD      2U       /* Store to the first loop iteration */
+#define BITBANG_LOW_OVERHEAD       14U      /* Store, next bit selection */
+#define BITBANG_UART_OVERHEAD      8U       /* Shift, write, bit loop control */
+
+/* WS2812 nominal phases (ns) and limits */
+#define WS2812_T0H_NS              400U
+#define WS2812_T1H_NS              800U
+#define WS2812_T0L_NS              850U
+#define WS2812_T1L_NS              450U
+#define WS2812_TOL_NS              150U
+#define WS2812_LOW_MAX_NS          5000U    /* A longer low phase may latch the strip */
+#define WS2812_MIN_HCLK            24000000U /* Lowest HCLK checked by tools/bitbang_timing_model.c */
+
+/* 1-Wire standard speed segments (us) */
+#define OW_A_US                    6U
+#define OW_C_US                    60U
+#define OW_D_US                    10U
+#define OW_E_US                    9U
+#define OW_F_US                    55U
+#define OW_H_US                    480U
+#define OW_I_US                    70U
+#define OW_J_US                    410U
+/* Private macro -------------------------------------------------------------*/
+#define SYSTICK_STE_BIT            (1u << 0)
+/* Private variables ---------------------------------------------------------*/
+static BITBANG_TimingTypeDef BitbangTiming;
+static RCC_ClockNotifierTypeDef BitbangNotifier;
+/* Private function prototypes -----------------------------------------------*/
+static HAL_StatusTypeDef BITBANG_ComputeTiming(void);
+static uint8_t BITBANG_TimingValid(void);
+static void BITBANG_ClockChangeCallback(const RCC_ClocksTypeDef *RCC_Clocks, void *Context);
+static uint32_t BITBANG_Calibrate(void);
+static uint32_t BITBANG_CyclesToLoops(uint32_t Cycles, uint32_t Overhead);
+static uint32_t BITBANG_NsToLoops(uint32_t Ns, uint32_t Overhead);
+static uint8_t BITBANG_OW_Bit(const BITBANG_OneWireTypeDef *how, uint8_t Bit);
+static HAL_StatusTypeDef BITBANG_UART_Loops(const BITBANG_UartTypeDef *hsu, uint32_t *BitLoops, uint32_t *HalfBitLoops);
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Measures the spin loop cost and converts every protocol phase to loops.
+  * @note   SysTick must be running (HAL_TickInit). The timing is recomputed
+  *         automatically on every system clock change, flash wait states
+  *         included. Software UART handles are re-timed on their next transfer.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_BITBANG_Init(void)
+{
+    if (BITBANG_ComputeTiming() != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    BitbangNotifier.Callback = BITBANG_ClockChangeCallback;
+    BitbangNotifier.Context = NULL;
+
+    return HAL_RCC_RegisterClockNotifier(&BitbangNotifier);
+}
+
+/**
+  * @brief  Sends a WS2812 frame then waits for the latch time.
+  * @note   Interrupts are masked for the whole frame, about 30us per LED: an
+  *         interrupt served between two bits would stretch a low phase past
+  *         the latch threshold (WS2812_LOW_MAX_NS) and cut the frame.
+  *         Tick interrupts beyond the first pending one are lost while the
+  *         frame is sent.
+  * @param  GPIOx where x can be (A..D), pin configured as GPIO_Mode_Out_PP.
+  * @param  GPIO_Pin GPIO_Pin_x where x can be (0..7).
+  * @param  pData pointer to the colour bytes, in the strip order (usually G, R, B).
+  * @param  Size number of bytes.
+  * @retval HAL_ERROR if the timing is not valid or HCLK is below
+  *         WS2812_MIN_HCLK, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_BITBANG_WS2812_Write(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, const uint8_t *pData, uint16_t Size)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
+    HAL_PARAM_CHECK(IS_GPIO_PIN(GPIO_Pin));
+
+    const BITBANG_TimingTypeDef *t = &BitbangTiming;
+    uint32_t high = 0x00, low = 0x00, ms = 0x00;
+    uint8_t byte = 0x00, mask = 0x00;
+
+    /* One cycle must stay well below the phase tolerance */
+    if ((BITBANG_TimingValid() == FALSE) || (t->Hclk < WS2812_MIN_HCLK))
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+
+    while (Size-- > 0U)
+    {
+        byte = *pData++;
+
+        for (mask = 0x80U; mask != 0U; mask >>= 1)
+        {
+            high = ((byte & mask) != 0U) ? t->Ws1H : t->Ws0H;
+            low  = ((byte & mask) != 0U) ? t->Ws1L : t->Ws0L;
+
+            HAL_GPIO_FastSet(GPIOx, GPIO_Pin);
+            HAL_BITBANG_Spin(high);
+            HAL_GPIO_FastReset(GPIOx, GPIO_Pin);
+            HAL_BITBANG_Spin(low);
+        }
+    }
+
+    _irq_unlock(ms);
+
+    HAL_DelayUs(HAL_BITBANG_WS2812_LATCH_US);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Sends a 1-Wire reset pulse and samples the presence pulse.
+  * @note   Interrupts are masked from the release to the presence sample.
+  * @param  how pointer to a BITBANG_OneWireTypeDef.
+  * @retval HAL_OK if a device answered, HAL_ERROR otherwise.
+  */
+HAL_StatusTypeDef HAL_BITBANG_OW_Reset(const BITBANG_OneWireTypeDef *how)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(how->Port));
+    HAL_PARAM_CHECK(IS_GPIO_PIN(how->Pin));
+
+    GPIO_PinState presence = GPIO_PIN_SET;
+    uint32_t ms = 0x00;
+
+    HAL_GPIO_FastReset(how->Port, how->Pin);
+    HAL_DelayUs(OW_H_US);
+
+    ms = _irq_lock();
+    HAL_GPIO_FastSet(how->Port, how->Pin);
+    HAL_DelayUs(OW_I_US);
+    presence = HAL_GPIO_FastRead(how->Port, how->Pin);
+    _irq_unlock(ms);
+
+    HAL_DelayUs(OW_J_US);
+
+    return (presence == GPIO_PIN_RESET) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+  * @brief  Writes bytes on a 1-Wire bus, LSB first.
+  * @param  how pointer to a BITBANG_OneWireTypeDef.
+  * @param  pData pointer to data buffer.
+  * @param  Size amount of bytes to be written.
+  * @retval HAL_ERROR if the timing is not valid, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_BITBANG_OW_Write(const BITBANG_OneWireTypeDef *how, const uint8_t *pData, uint16_t Size)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(how->Port));
+    HAL_PARAM_CHECK(IS_GPIO_PIN(how->Pin));
+
+    uint8_t byte = 0x00, bit = 0x00;
+
+    if (BITBANG_TimingValid() == FALSE)
+    {
+        return HAL_ERROR;
+    }
+
+    while (Size-- > 0U)
+    {
+        byte = *pData++;
+
+        for (bit = 0x00; bit < 8U; bit++, byte >>= 1)
+        {
+            (void)BITBANG_OW_Bit(how, byte & 0x01U);
+        }
+    }
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Reads bytes from a 1-Wire bus, LSB first.
+  * @param  how pointer to a BITBANG_OneWireTypeDef.
+  * @param  pData pointer to data buffer.
+  * @param  Size amount of bytes to be read.
+  * @retval HAL_ERROR if the timing is not valid, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_BITBANG_OW_Read(const BITBANG_OneWireTypeDef *how, uint8_t *pData, uint16_t Size)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(how->Port));
+    HAL_PARAM_CHECK(IS_GPIO_PIN(how->Pin));
+
+    uint8_t byte = 0x00, bit = 0x00;
+
+    if (BITBANG_TimingValid() == FALSE)
+    {
+        return HAL_ERROR;
+    }
+
+    while (Size-- > 0U)
+    {
+        byte = 0x00;
+
+        for (bit = 0x00; bit < 8U; bit++)
+        {
+            /* A read slot is a write '1' slot sampled after tE */
+            byte |= (uint8_t)(BITBANG_OW_Bit(how, 0x01U) << bit);
+        }
+
+        *pData++ = byte;
+    }
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Computes the bit timing of a software UART and idles its Tx line.
+  * @note   HAL_BITBANG_Init() must have been called and the pins configured
+  *         with HAL_GPIO_Init(), which holds the port clocks.
+  * @param  hsu pointer to a BITBANG_UartTypeDef.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_BITBANG_UART_Init(BITBANG_UartTypeDef *hsu)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(hsu->BaudRate != 0U);
+    HAL_PARAM_CHECK((hsu->TxPort == NULL) || IS_GPIO_INSTANCE(hsu->TxPort));
+    HAL_PARAM_CHECK((hsu->RxPort == NULL) || IS_GPIO_INSTANCE(hsu->RxPort));
+
+    /* Force the computation for this baud rate */
+    hsu->BitLoops = 0U;
+
+    if (BITBANG_UART_Loops(hsu, &hsu->BitLoops, &hsu->HalfBitLoops) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    hsu->Hclk = BitbangTiming.Hclk;
+
+    if (hsu->TxPort != NULL)
+    {
+        HAL_GPIO_FastSet(hsu->TxPort, hsu->TxPin);
+    }
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Sends bytes on a software UART (8N1).
+  * @note   Interrupts are masked for one frame (10 bits) at a time.
+  * @param  hsu pointer to an initialized BITBANG_UartTypeDef.
+  * @param  pData pointer to data buffer.
+  * @param  Size amount of bytes to be sent.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_BITBANG_UART_Transmit(const BITBANG_UartTypeDef *hsu, const uint8_t *pData, uint16_t Size)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(hsu->TxPort != NULL);
+    HAL_PARAM_CHECK(hsu->BitLoops != 0U);
+
+    GPIO_TypeDef *port = hsu->TxPort;
+    uint16_t pin = hsu->TxPin;
+    uint32_t loops = 0x00, half = 0x00;
+    uint32_t frame = 0x00, bit = 0x00, ms = 0x00;
+
+    if (BITBANG_UART_Loops(hsu, &loops, &half) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    while (Size-- > 0U)
+    {
+        /* Start bit, 8 data bits LSB first, stop bit */
+        frame = ((uint32_t)(*pData++) << 1) | 0x200U;
+
+        ms = _irq_lock();
+
+        for (bit = 0x00; bit < 10U; bit++, frame >>= 1)
+        {
+            HAL_GPIO_FastWrite(port, pin, (GPIO_PinState)(frame & 0x01U));
+            HAL_BITBANG_Spin(loops);
+        }
+
+        _irq_unlock(ms);
+    }
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Receives bytes on a software UART (8N1).
+  * @note   The start bit is polled with interrupts enabled, the rest of the
+  *         frame is sampled at mid-bit with interrupts masked.
+  * @param  hsu pointer to an initialized BITBANG_UartTypeDef.
+  * @param  pData pointer to data buffer.
+  * @param  Size amount of bytes to be received.
+  * @param  Timeout timeout duration of the whole transfer, in milliseconds.
+  * @retval HAL status, HAL_ERROR on a framing error.
+  */
+HAL_StatusTypeDef HAL_BITBANG_UART_Receive(const BITBANG_UartTypeDef *hsu, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(hsu->RxPort != NULL);
+    HAL_PARAM_CHECK(hsu->BitLoops != 0U);
+
+    GPIO_TypeDef *port = hsu->RxPort;
+    uint16_t pin = hsu->RxPin;
+    HAL_DeadlineTypeDef deadline;
+    uint32_t loops = 0x00, half = 0x00;
+    uint32_t ms = 0x00, bit = 0x00;
+    uint8_t byte = 0x00;
+    GPIO_PinState stop = GPIO_PIN_SET;
+
+    if (BITBANG_UART_Loops(hsu, &loops, &half) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    HAL_DeadlineStart(&deadline, Timeout);
+
+    while (Size > 0U)
+    {
+        /* Wait for the start bit */
+        while (HAL_GPIO_FastRead(port, pin) != GPIO_PIN_RESET)
+        {
+            if (HAL_DeadlineExpired(&deadline) != FALSE)
+            {
+                return HAL_TIMEOUT;
+            }
+        }
+
+        ms = _irq_lock();
+        HAL_BITBANG_Spin(half);
+
+        /* Glitch, not a start bit */
+        if (HAL_GPIO_FastRead(port, pin) != GPIO_PIN_RESET)
+        {
+            _irq_unlock(ms);
+            continue;
+        }
+
+        byte = 0x00;
+
+        for (bit = 0x00; bit < 8U; bit++)
+        {
+            HAL_BITBANG_Spin(loops);
+            byte |= (uint8_t)((uint8_t)HAL_GPIO_FastRead(port, pin) << bit);
+        }
+
+        HAL_BITBANG_Spin(loops);
+        stop = HAL_GPIO_FastRead(port, pin);
+        _irq_unlock(ms);
+
+        if (stop != GPIO_PIN_SET)
+        {
+            return HAL_ERROR;
+        }
+
+        *pData++ = byte;
+        Size--;
+    }
+
+    return HAL_OK;
+}
+
+/* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Measures the spin loop cost and converts every protocol phase to loops.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef BITBANG_ComputeTiming(void)
+{
+    BITBANG_TimingTypeDef *t = &BitbangTiming;
+    uint32_t loop_cycles16 = 0x00;
+
+    if (((READ_REG(SysTick->CTLR) & SYSTICK_STE_BIT) == 0U) || (READ_REG(SysTick->CMP) == 0U))
+    {
+        return HAL_ERROR;
+    }
+
+    loop_cycles16 = BITBANG_Calibrate();
+
+    if (loop_cycles16 == 0U)
+    {
+        return HAL_ERROR;
+    }
+
+    t->Hclk = SystemCoreClock;
+    t->LoopCycles16 = loop_cycles16;
+
+    t->Ws0H = BITBANG_NsToLoops(WS2812_T0H_NS, BITBANG_HIGH_OVERHEAD);
+    t->Ws1H = BITBANG_NsToLoops(WS2812_T1H_NS, BITBANG_HIGH_OVERHEAD);
+    t->Ws0L = BITBANG_NsToLoops(WS2812_T0L_NS, BITBANG_LOW_OVERHEAD);
+    t->Ws1L = BITBANG_NsToLoops(WS2812_T1L_NS, BITBANG_LOW_OVERHEAD);
+
+    t->OwA = BITBANG_NsToLoops(OW_A_US * 1000U, BITBANG_HIGH_OVERHEAD);
+    t->OwC = BITBANG_NsToLoops(OW_C_US * 1000U, BITBANG_HIGH_OVERHEAD);
+    t->OwD = BITBANG_NsToLoops(OW_D_US * 1000U, BITBANG_LOW_OVERHEAD);
+    t->OwE = BITBANG_NsToLoops(OW_E_US * 1000U, BITBANG_HIGH_OVERHEAD);
+    t->OwF = BITBANG_NsToLoops(OW_F_US * 1000U, BITBANG_LOW_OVERHEAD);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Tells whether the loop counts match the running clock.
+  * @note   Every engine checks it first: with a zero LoopCycles16 the phases
+  *         are meaningless and HAL_BITBANG_Spin(0) would run 2^32 loops.
+  * @retval TRUE if HAL_BITBANG_Init() succeeded at the current HCLK.
+  */
+static uint8_t BITBANG_TimingValid(void)
+{
+    return ((BitbangTiming.LoopCycles16 != 0U) && (BitbangTiming.Hclk == SystemCoreClock)) ? TRUE : FALSE;
+}
+
+/**
+  * @brief  Clock change notifier, re-measures the spin loop at the new clock.
+  * @note   On failure every engine reports HAL_ERROR until HAL_BITBANG_Init()
+  *         succeeds again.
+  * @param  RCC_Clocks new clock frequencies, unused.
+  * @param  Context unused.
+  * @retval None
+  */
+static void BITBANG_ClockChangeCallback(const RCC_ClocksTypeDef *RCC_Clocks, void *Context)
+{
+    UNUSED(RCC_Clocks);
+    UNUSED(Context);
+
+    if (BITBANG_ComputeTiming() != HAL_OK)
+    {
+        BitbangTiming.LoopCycles16 = 0U;
+    }
+}
+
+/**
+  * @brief  Times BITBANG_CAL_LOOPS spin iterations against SysTick.
+  * @retval cycles per iteration with 4 fractional bits, 0 on failure.
+  */
+static uint32_t BITBANG_Calibrate(void)
+{
+    HAL_TickSpanTypeDef span;
+    uint32_t delta = 0x00;
+    uint32_t ms = _irq_lock();
+
+    HAL_TickSpanStart(&span);
+    HAL_BITBANG_Spin(BITBANG_CAL_LOOPS);
+    delta = HAL_TickSpanElapsed(&span);
+
+    _irq_unlock(ms);
+
+    return (delta + 8U) >> 4;
+}
+
+/**
+  * @brief  Converts a phase length in cycles to spin loops.
+  * @param  Cycles phase length in HCLK cycles.
+  * @param  Overhead fixed cycles spent around the spin.
+  * @retval loops, at least 1.
+  */
+static uint32_t BITBANG_CyclesToLoops(uint32_t Cycles, uint32_t Overhead)
+{
+    uint32_t loop_cycles16 = BitbangTiming.LoopCycles16;
+    uint32_t loops = 0x00;
+
+    if (Cycles <= Overhead)
+    {
+        return 1U;
+    }
+
+    loops = (uint32_t)((((uint64_t)(Cycles - Overhead) << 4) + (loop_cycles16 >> 1)) / loop_cycles16);
+
+    return (loops == 0U) ? 1U : loops;
+}
+
+/**
+  * @brief  Converts a phase length in nanoseconds to spin loops.
+  * @retval loops, at least 1.
+  */
+static uint32_t BITBANG_NsToLoops(uint32_t Ns, uint32_t Overhead)
+{
+    uint32_t cycles = (uint32_t)(((uint64_t)Ns * SystemCoreClock + 500000000U) / 1000000000U);
+
+    return BITBANG_CyclesToLoops(cycles, Overhead);
+}
+
+/**
+  * @brief  Runs one 1-Wire time slot.
+  * @note   Interrupts are masked from the falling edge to the sample point,
+  *         the recovery part of the slot runs unmasked.
+  * @param  how pointer to a BITBANG_OneWireTypeDef.
+  * @param  Bit bit to write, 1 also runs a read slot.
+  * @retval bus level sampled tA + tE after the falling edge.
+  */
+static uint8_t BITBANG_OW_Bit(const BITBANG_OneWireTypeDef *how, uint8_t Bit)
+{
+    const BITBANG_TimingTypeDef *t = &BitbangTiming;
+    GPIO_TypeDef *port = how->Port;
+    uint16_t pin = how->Pin;
+    uint8_t level = 0x00;
+    uint32_t ms = 0x00;
+
+    ms = _irq_lock();
+    HAL_GPIO_FastReset(port, pin);
+
+    if (Bit != 0U)
+    {
+        HAL_BITBANG_Spin(t->OwA);
+        HAL_GPIO_FastSet(port, pin);
+        HAL_BITBANG_Spin(t->OwE);
+        level = (uint8_t)HAL_GPIO_FastRead(port, pin);
+        _irq_unlock(ms);
+        HAL_BITBANG_Spin(t->OwF);
+    }
+    else
+    {
+        HAL_BITBANG_Spin(t->OwC);
+        HAL_GPIO_FastSet(port, pin);
+        _irq_unlock(ms);
+        HAL_BITBANG_Spin(t->OwD);
+    }
+
+    return level;
+}
+
+/**
+  * @brief  Spin loops per bit and half bit of a software UART at the current clock.
+  * @note   The loop counts stored in the handle are used as long as the clock
+  *         did not change since HAL_BITBANG_UART_Init(), they are recomputed
+  *         (two divisions) otherwise.
+  * @param  hsu pointer to a BITBANG_UartTypeDef.
+  * @param  BitLoops receives the loops per bit.
+  * @param  HalfBitLoops receives the loops per half bit.
+  * @retval HAL_ERROR if HAL_BITBANG_Init() did not succeed, HAL_OK otherwise.
+  */
+static HAL_StatusTypeDef BITBANG_UART_Loops(const BITBANG_UartTypeDef *hsu, uint32_t *BitLoops, uint32_t *HalfBitLoops)
+{
+    uint32_t bit_cycles = 0x00;
+
+    if (BITBANG_TimingValid() == FALSE)
+    {
+        return HAL_ERROR;
+    }
+
+    if ((hsu->Hclk == BitbangTiming.Hclk) && (hsu->BitLoops != 0U))
+    {
+        *BitLoops = hsu->BitLoops;
+        *HalfBitLoops = hsu->HalfBitLoops;
+        return HAL_OK;
+    }
+
+    bit_cycles = BitbangTiming.Hclk / hsu->BaudRate;
+    *BitLoops = BITBANG_CyclesToLoops(bit_cycles, BITBANG_UART_OVERHEAD);
+    *HalfBitLoops = BITBANG_CyclesToLoops(bit_cycles >> 1, BITBANG_UART_OVERHEAD);
+
+    return HAL_OK;
+}
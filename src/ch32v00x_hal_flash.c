@@ -15,13 +15,16 @@
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
-static HAL_StatusTypeDef FLASH_Program_Word(FLASH_HandleTypeDef* hflash, uint32_t Data);
-static HAL_StatusTypeDef FLASH_Program_HalfWord(FLASH_HandleTypeDef* hflash, uint16_t Data);
-static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_t Data);
-static HAL_StatusTypeDef FLASH_Erase_Page(FLASH_HandleTypeDef* hflash);
-static HAL_StatusTypeDef FLASH_Erase_Sector(FLASH_HandleTypeDef* hflash);
-static HAL_StatusTypeDef FLASH_Erase_Mass(FLASH_HandleTypeDef* hflash);
-static HAL_StatusTypeDef FLASH_WaitForLastOperation(FLASH_HandleTypeDef* hflash, uint32_t Timeout);
+static HAL_StatusTypeDef FLASH_Program(FLASH_HandleTypeDef* hflash, uint64_t Data, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_Erase(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_Program_Word(FLASH_HandleTypeDef* hflash, uint32_t Data, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_Program_HalfWord(FLASH_HandleTypeDef* hflash, uint16_t Data, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_t Data, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_Erase_Page(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_Erase_Sector(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_Erase_Mass(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_WaitForLastOperation(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef FLASH_CheckErased(FLASH_HandleTypeDef* hflash, uint32_t Start, uint32_t End);
 static HAL_FLASH_Error FLASH_GetError(FLASH_HandleTypeDef* hflash);
 static void FLASH_ClearError(FLASH_HandleTypeDef* hflash);
 /* Exported functions ---------------------------------------------------------*/
@@ -33,6 +36,70 @@ static void FLASH_ClearError(FLASH_HandleTypeDef* hflash);
   * @retval HAL_StatusTypeDef HAL Status
   */
 HAL_StatusTypeDef HAL_FLASH_Program(FLASH_HandleTypeDef* hflash, uint64_t Data)
+{
+    HAL_DeadlineTypeDef deadline;
+
+    HAL_DeadlineStart(&deadline, FLASH_PROGRAM_TIMEOUT);
+
+    return FLASH_Program(hflash, Data, &deadline);
+}
+
+/**
+  * @brief  Program halfword, word or page with a timeout in microseconds.
+  * @param  hflash  Flash handle instance.
+  * @param  Data specifies the data to be programmed.
+  * @param  TimeoutUs timeout of the whole operation in microseconds.
+  *
+  * @retval HAL_StatusTypeDef HAL Status
+  */
+HAL_StatusTypeDef HAL_FLASH_Program_Us(FLASH_HandleTypeDef* hflash, uint64_t Data, uint32_t TimeoutUs)
+{
+    HAL_DeadlineTypeDef deadline;
+
+    HAL_DeadlineStartUs(&deadline, TimeoutUs);
+
+    return FLASH_Program(hflash, Data, &deadline);
+}
+
+/**
+  * @brief  Erase sector, page at a specified address or mass memory.
+  * @param  hflash  Flash handle instance.
+  *
+  * @retval HAL_StatusTypeDef HAL Status
+  */
+HAL_StatusTypeDef HAL_FLASH_Erase(FLASH_HandleTypeDef* hflash)
+{
+    HAL_DeadlineTypeDef deadline;
+
+    HAL_DeadlineStart(&deadline, FLASH_ERASE_TIMEOUT);
+
+    return FLASH_Erase(hflash, &deadline);
+}
+
+/**
+  * @brief  Erase sector, page or mass memory with a timeout in microseconds.
+  * @param  hflash  Flash handle instance.
+  * @param  TimeoutUs timeout of the whole operation in microseconds.
+  *
+  * @retval HAL_StatusTypeDef HAL Status
+  */
+HAL_StatusTypeDef HAL_FLASH_Erase_Us(FLASH_HandleTypeDef* hflash, uint32_t TimeoutUs)
+{
+    HAL_DeadlineTypeDef deadline;
+
+    HAL_DeadlineStartUs(&deadline, TimeoutUs);
+
+    return FLASH_Erase(hflash, &deadline);
+}
+
+/**
+  * @brief  Start an erase of a sector, page or mass memory without waiting.
+  * @note   Completion is collected with HAL_FLASH_Finish().
+  * @param  hflash  Flash handle instance.
+  *
+  * @retval HAL_StatusTypeDef HAL Status (HAL_BUSY if an operation is ongoing)
+  */
+HAL_StatusTypeDef HAL_FLASH_Erase_Start(FLASH_HandleTypeDef* hflash)
 {
     if (hflash == NULL)
     {
@@ -41,105 +108,107 @@ HAL_StatusTypeDef HAL_FLASH_Program(FLASH_HandleTypeDef* hflash, uint64_t Data)
 
     /* Check the parameters */
     HAL_PARAM_CHECK(IS_FLASH_PROGRAM_METHOD(hflash->Flash_ProgramMethod));
-    HAL_PARAM_CHECK(IS_FLASH_TYPE_PROGRAM(hflash->Flash_ProgramType));
-    HAL_PARAM_CHECK(IS_FLASH_VALID_ADDRESS(hflash->Flash_ProgramAdress));
+    HAL_PARAM_CHECK(IS_FLASH_TYPE_ERASE(hflash->Flash_EraseType));
+    HAL_PARAM_CHECK(IS_FLASH_VALID_ADDRESS(hflash->Flash_EraseAddress));
 
-    HAL_StatusTypeDef status;
+    uint32_t mode;
 
-    switch (hflash->Flash_ProgramMethod)
+    if ((hflash->Flash_ProgramMethod == FLASH_PROG_METHOD_DEFAULT) &&
+        (hflash->Flash_EraseType == FLASH_TYPE_ERASE_SECTOR))
     {
-        case FLASH_PROG_METHOD_DEFAULT:
-            if (hflash->Flash_ProgramType == FLASH_TYPE_PROGRAM_HALFWORD)
-            {
-                /* Program halfword (16-bit) at a specified address. */
-                status = FLASH_Program_HalfWord(hflash, (uint16_t)Data);
-            }
-            else if (hflash->Flash_ProgramType == FLASH_TYPE_PROGRAM_WORD)
-            {
-                /* Program word (32-bit) at a specified address. */
-                status = FLASH_Program_Word(hflash, (uint32_t)Data);
-            }
-            else
-            {
-                ;
-            }
-
-            break;
-        case FLASH_PROG_METHOD_FAST:
-            if (hflash->Flash_ProgramType == FLASH_TYPE_PROGRAM_PAGE)
-            {
-                /* Fast program 64 bytes at a 64-byte aligned page address. */
-                status = FLASH_Program_Page(hflash, (uint32_t)Data);
-            }
-            else
-            {
-                ;
-            }
+        if ((hflash->Flash_EraseAddress & (FLASH_PAGE_SIZE - 1U)) != 0U)
+        {
+            hflash->ErrorCode |= HAL_FLASH_ERROR_ALIGN;
+            return HAL_ERROR;
+        }
+        mode = FLASH_CTLR_PER;
+    }
+    else if ((hflash->Flash_ProgramMethod == FLASH_PROG_METHOD_FAST) &&
+             (hflash->Flash_EraseType == FLASH_TYPE_ERASE_PAGE))
+    {
+        if ((hflash->Flash_EraseAddress & 0x3FU) != 0U)
+        {
+            hflash->ErrorCode |= HAL_FLASH_ERROR_ALIGN;
+            return HAL_ERROR;
+        }
+        mode = FLASH_CTLR_PAGE_ER;
+    }
+    else if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_MASS)
+    {
+        mode = FLASH_CTLR_MER;
+    }
+    else
+    {
+        return HAL_ERROR;
+    }
 
-            break;
-        default:
-            break;
+    if (__HAL_FLASH_GET_FLAG(FLASH_FLAG_BSY) != 0U)
+    {
+        return HAL_BUSY;
     }
 
-    return status;
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_WRPRTERR);
+
+    SET_BIT(FLASH->CTLR, mode);
+    WRITE_REG(FLASH->ADDR, hflash->Flash_EraseAddress);
+    SET_BIT(FLASH->CTLR, FLASH_CTLR_STRT);
+
+    return HAL_OK;
 }
 
 /**
-  * @brief  Erase sector, page at a specified address or mass memory.
+  * @brief  Collect the result of an erase started by HAL_FLASH_Erase_Start().
+  * @note   Never waits: returns HAL_BUSY while the controller is still busy.
+  *         On completion the write protection error is reported and the
+  *         erased range is checked like the blocking HAL_FLASH_Erase().
   * @param  hflash  Flash handle instance.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-HAL_StatusTypeDef HAL_FLASH_Erase(FLASH_HandleTypeDef* hflash)
+HAL_StatusTypeDef HAL_FLASH_Finish(FLASH_HandleTypeDef* hflash)
 {
     if (hflash == NULL)
     {
         return HAL_ERROR;
     }
 
-    /* Check the parameters */
-    HAL_PARAM_CHECK(IS_FLASH_PROGRAM_METHOD(hflash->Flash_ProgramMethod));
-    HAL_PARAM_CHECK(IS_FLASH_TYPE_ERASE(hflash->Flash_EraseType));
-    HAL_PARAM_CHECK(IS_FLASH_VALID_ADDRESS(hflash->Flash_EraseAddress));
+    if (__HAL_FLASH_GET_FLAG(FLASH_FLAG_BSY) != 0U)
+    {
+        return HAL_BUSY;
+    }
 
-    HAL_StatusTypeDef status;
+    uint32_t mode = READ_BIT(FLASH->CTLR, FLASH_CTLR_PER | FLASH_CTLR_PAGE_ER | FLASH_CTLR_MER);
+    HAL_StatusTypeDef status = HAL_OK;
 
-    switch (hflash->Flash_ProgramMethod)
+    CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PER | FLASH_CTLR_PAGE_ER | FLASH_CTLR_MER);
+
+    if (__HAL_FLASH_GET_FLAG(FLASH_FLAG_EOP) != 0U)
     {
-        case FLASH_PROG_METHOD_DEFAULT:
-            if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_SECTOR)
-            {
-                /* Erase a sector (1KB). */
-                status = FLASH_Erase_Sector(hflash);
-            }
-            else if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_MASS)
-            {
-                /* Erase all pages (16KB). */
-                status = FLASH_Erase_Mass(hflash);
-            }
-            else
-            {
-                ;
-            }
+        __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP);
+    }
 
-            break;
-        case FLASH_PROG_METHOD_FAST:
-            if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_PAGE)
-            {
-                /* Erase a page (64 bytes). */
-                status = FLASH_Erase_Page(hflash);
-            }
-            else if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_MASS)
-            {
-                /* Erase all pages (16KB). */
-                status = FLASH_Erase_Mass(hflash);
-            }
-            else
-            {
-                ;
-            }
-        default:
-            break;
+    if (__HAL_FLASH_GET_FLAG(FLASH_FLAG_WRPRTERR) != 0U)
+    {
+        __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_WRPRTERR);
+        hflash->ErrorCode |= HAL_FLASH_ERROR_WRP;
+        return HAL_ERROR;
+    }
+
+    if (mode == FLASH_CTLR_PER)
+    {
+        status = FLASH_CheckErased(hflash, hflash->Flash_EraseAddress, hflash->Flash_EraseAddress + FLASH_PAGE_SIZE);
+    }
+    else if (mode == FLASH_CTLR_PAGE_ER)
+    {
+        status = FLASH_CheckErased(hflash, hflash->Flash_EraseAddress, hflash->Flash_EraseAddress + 64U);
+    }
+    else if (mode == FLASH_CTLR_MER)
+    {
+        status = FLASH_CheckErased(hflash, VALID_ADDR_START, VALID_ADDR_END);
+    }
+    else
+    {
+        ;
     }
 
     return status;
@@ -185,6 +254,9 @@ HAL_StatusTypeDef HAL_FLASH_Unlock(FLASH_HandleTypeDef* hflash)
         }
     }
 
+    /* Flash session timed up to HAL_FLASH_Lock(), only once unlocked */
+    HAL_BOOT_PHASE_BEGIN(RCC_BOOT_PHASE_FLASH);
+
     return HAL_OK;
 }
 
@@ -203,6 +275,8 @@ HAL_StatusTypeDef HAL_FLASH_Lock(FLASH_HandleTypeDef* hflash)
 
     SET_BIT(FLASH->CTLR, FLASH_CTLR_LOCK);
 
+    HAL_BOOT_PHASE_END(RCC_BOOT_PHASE_FLASH);
+
     /* Verify Flash is locked */
     if (!IS_BIT_SET(FLASH->CTLR, FLASH_CTLR_LOCK))
     {
@@ -245,14 +319,137 @@ HAL_StatusTypeDef HAL_FLASH_SystemReset(FLASH_HandleTypeDef* hflash, uint32_t Mo
 }
 
 /* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Program halfword, word or page at a specified address.
+  * @param  hflash  Flash handle instance.
+  * @param  Data specifies the data to be programmed.
+  * @param  Deadline Deadline of the whole operation.
+  *
+  * @retval HAL_StatusTypeDef HAL Status
+  */
+static HAL_StatusTypeDef FLASH_Program(FLASH_HandleTypeDef* hflash, uint64_t Data, const HAL_DeadlineTypeDef *Deadline)
+{
+    if (hflash == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_FLASH_PROGRAM_METHOD(hflash->Flash_ProgramMethod));
+    HAL_PARAM_CHECK(IS_FLASH_TYPE_PROGRAM(hflash->Flash_ProgramType));
+    HAL_PARAM_CHECK(IS_FLASH_VALID_ADDRESS(hflash->Flash_ProgramAdress));
+
+    HAL_StatusTypeDef status = HAL_ERROR;
+
+    switch (hflash->Flash_ProgramMethod)
+    {
+        case FLASH_PROG_METHOD_DEFAULT:
+            if (hflash->Flash_ProgramType == FLASH_TYPE_PROGRAM_HALFWORD)
+            {
+                /* Program halfword (16-bit) at a specified address. */
+                status = FLASH_Program_HalfWord(hflash, (uint16_t)Data, Deadline);
+            }
+            else if (hflash->Flash_ProgramType == FLASH_TYPE_PROGRAM_WORD)
+            {
+                /* Program word (32-bit) at a specified address. */
+                status = FLASH_Program_Word(hflash, (uint32_t)Data, Deadline);
+            }
+            else
+            {
+                ;
+            }
+
+            break;
+        case FLASH_PROG_METHOD_FAST:
+            if (hflash->Flash_ProgramType == FLASH_TYPE_PROGRAM_PAGE)
+            {
+                /* Fast program 64 bytes at a 64-byte aligned page address. */
+                status = FLASH_Program_Page(hflash, (uint32_t)Data, Deadline);
+            }
+            else
+            {
+                ;
+            }
+
+            break;
+        default:
+            break;
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Erase sector, page at a specified address or mass memory.
+  * @param  hflash  Flash handle instance.
+  * @param  Deadline Deadline of the whole operation.
+  *
+  * @retval HAL_StatusTypeDef HAL Status
+  */
+static HAL_StatusTypeDef FLASH_Erase(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline)
+{
+    if (hflash == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_FLASH_PROGRAM_METHOD(hflash->Flash_ProgramMethod));
+    HAL_PARAM_CHECK(IS_FLASH_TYPE_ERASE(hflash->Flash_EraseType));
+    HAL_PARAM_CHECK(IS_FLASH_VALID_ADDRESS(hflash->Flash_EraseAddress));
+
+    HAL_StatusTypeDef status = HAL_ERROR;
+
+    switch (hflash->Flash_ProgramMethod)
+    {
+        case FLASH_PROG_METHOD_DEFAULT:
+            if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_SECTOR)
+            {
+                /* Erase a sector (1KB). */
+                status = FLASH_Erase_Sector(hflash, Deadline);
+            }
+            else if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_MASS)
+            {
+                /* Erase all pages (16KB). */
+                status = FLASH_Erase_Mass(hflash, Deadline);
+            }
+            else
+            {
+                ;
+            }
+
+            break;
+        case FLASH_PROG_METHOD_FAST:
+            if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_PAGE)
+            {
+                /* Erase a page (64 bytes). */
+                status = FLASH_Erase_Page(hflash, Deadline);
+            }
+            else if (hflash->Flash_EraseType == FLASH_TYPE_ERASE_MASS)
+            {
+                /* Erase all pages (16KB). */
+                status = FLASH_Erase_Mass(hflash, Deadline);
+            }
+            else
+            {
+                ;
+            }
+        default:
+            break;
+    }
+
+    return status;
+}
+
 /**
   * @brief  Program word or page at a specified address.
   * @param  hflash  Flash handle instance.
   * @param  Data specifies the data to be programmed.
+  * @param  Deadline Deadline of the whole operation.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-static HAL_StatusTypeDef FLASH_Program_Word(FLASH_HandleTypeDef* hflash, uint32_t Data)
+static HAL_StatusTypeDef FLASH_Program_Word(FLASH_HandleTypeDef* hflash, uint32_t Data, const HAL_DeadlineTypeDef *Deadline)
 {
     HAL_StatusTypeDef status;
 
@@ -262,19 +459,19 @@ static HAL_StatusTypeDef FLASH_Program_Word(FLASH_HandleTypeDef* hflash, uint32_
         return HAL_ERROR;
     }
 
-    status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
 
     if (status == HAL_OK)
     {
         SET_BIT(FLASH->CTLR, FLASH_CTLR_PG);
 
         *(__IO uint16_t *)hflash->Flash_ProgramAdress = (uint16_t)Data;
-        status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+        status = FLASH_WaitForLastOperation(hflash, Deadline);
 
         if (status == HAL_OK)
         {
             *(__IO uint16_t *)(hflash->Flash_ProgramAdress + 2U) = (uint16_t)(Data >> 16);
-            status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+            status = FLASH_WaitForLastOperation(hflash, Deadline);
             CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PG);
         }
         else
@@ -299,10 +496,11 @@ static HAL_StatusTypeDef FLASH_Program_Word(FLASH_HandleTypeDef* hflash, uint32_
   * @brief  Program halfword at a specified address.
   * @param  hflash  Flash handle instance.
   * @param  Data specifies the data to be programmed.
+  * @param  Deadline Deadline of the whole operation.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-static HAL_StatusTypeDef FLASH_Program_HalfWord(FLASH_HandleTypeDef* hflash, uint16_t Data)
+static HAL_StatusTypeDef FLASH_Program_HalfWord(FLASH_HandleTypeDef* hflash, uint16_t Data, const HAL_DeadlineTypeDef *Deadline)
 {
     HAL_StatusTypeDef status;
 
@@ -312,13 +510,13 @@ static HAL_StatusTypeDef FLASH_Program_HalfWord(FLASH_HandleTypeDef* hflash, uin
         return HAL_ERROR;
     }
 
-    status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
 
     if (status == HAL_OK)
     {
         SET_BIT(FLASH->CTLR, FLASH_CTLR_PG);
         *(__IO uint16_t *)hflash->Flash_ProgramAdress = Data;
-        status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+        status = FLASH_WaitForLastOperation(hflash, Deadline);
         CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PG);
 
         if (status == HAL_OK)
@@ -338,10 +536,11 @@ static HAL_StatusTypeDef FLASH_Program_HalfWord(FLASH_HandleTypeDef* hflash, uin
   * @brief  Program page at a specified address.
   * @param  hflash  Flash handle instance.
   * @param  Data specifies the data to be programmed.
+  * @param  Deadline Deadline of the whole operation.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_t Data)
+static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_t Data, const HAL_DeadlineTypeDef *Deadline)
 {
     HAL_StatusTypeDef status;
     const uint32_t *w = (const uint32_t *)(uintptr_t)Data;
@@ -359,7 +558,7 @@ static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_
         return HAL_ERROR;
     }
 
-    status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
     if (status != HAL_OK)
     {
         return status;
@@ -367,7 +566,7 @@ static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_
 
     SET_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_PG);
     SET_BIT(FLASH->CTLR, FLASH_CTLR_BUF_RST);
-    status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
     CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_PG);
 
     if (status != HAL_OK)
@@ -380,7 +579,7 @@ static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_
         SET_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_PG);
         *(__IO uint32_t *)(hflash->Flash_ProgramAdress + (i * 4U)) = w[i];
         SET_BIT(FLASH->CTLR, FLASH_CTLR_BUF_LOAD);
-        status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+        status = FLASH_WaitForLastOperation(hflash, Deadline);
         CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_PG);
 
         if (status != HAL_OK)
@@ -392,7 +591,7 @@ static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_
     SET_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_PG);
     WRITE_REG(FLASH->ADDR, hflash->Flash_ProgramAdress);
     SET_BIT(FLASH->CTLR, FLASH_CTLR_STRT);
-    status = FLASH_WaitForLastOperation(hflash, FLASH_PROGRAM_TIMEOUT);
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
     CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_PG);
 
     if (status == HAL_OK)
@@ -414,10 +613,11 @@ static HAL_StatusTypeDef FLASH_Program_Page(FLASH_HandleTypeDef* hflash, uint32_
 /**
   * @brief  Erase page at a specified address.
   * @param  hflash  Flash handle instance.
+  * @param  Deadline Deadline of the whole operation.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-static HAL_StatusTypeDef FLASH_Erase_Page(FLASH_HandleTypeDef* hflash)
+static HAL_StatusTypeDef FLASH_Erase_Page(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline)
 {
     if ((hflash->Flash_EraseAddress & 0x3FU) != 0U)
     {
@@ -425,39 +625,32 @@ static HAL_StatusTypeDef FLASH_Erase_Page(FLASH_HandleTypeDef* hflash)
         return HAL_ERROR;
     }
 
-    uint32_t start, end;
+    HAL_StatusTypeDef status;
 
     SET_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_ER);
     WRITE_REG(FLASH->ADDR, hflash->Flash_EraseAddress);
     SET_BIT(FLASH->CTLR, FLASH_CTLR_STRT);
-    while (__HAL_FLASH_GET_FLAG(FLASH_FLAG_BSY)) {}
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
     CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PAGE_ER);
 
-    start = hflash->Flash_EraseAddress;
-    end = start + 64U;
-    while (start < end)
+    if (status != HAL_OK)
     {
-        if (*(__IO uint16_t *)start != 0xFFFFU)
-        {
-            hflash->ErrorCode |= HAL_FLASH_ERROR_PROG;
-            return HAL_ERROR;
-        }
-        start += 2U;
+        return status;
     }
 
-    return HAL_OK;
+    return FLASH_CheckErased(hflash, hflash->Flash_EraseAddress, hflash->Flash_EraseAddress + 64U);
 }
 
 /**
   * @brief  Erase sector at a specified address.
   * @param  hflash  Flash handle instance.
+  * @param  Deadline Deadline of the whole operation.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-static HAL_StatusTypeDef FLASH_Erase_Sector(FLASH_HandleTypeDef* hflash)
+static HAL_StatusTypeDef FLASH_Erase_Sector(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline)
 {
     HAL_StatusTypeDef status;
-    uint32_t start, end;
 
     if ((hflash->Flash_EraseAddress & (FLASH_PAGE_SIZE - 1U)) != 0U)
     {
@@ -465,14 +658,14 @@ static HAL_StatusTypeDef FLASH_Erase_Sector(FLASH_HandleTypeDef* hflash)
         return HAL_ERROR;
     }
 
-    status = FLASH_WaitForLastOperation(hflash, FLASH_ERASE_TIMEOUT);
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
 
     if (status == HAL_OK)
     {
         SET_BIT(FLASH->CTLR,FLASH_CTLR_PER);
         WRITE_REG(FLASH->ADDR, hflash->Flash_EraseAddress);
         SET_BIT(FLASH->CTLR,FLASH_CTLR_STRT);
-        status = FLASH_WaitForLastOperation(hflash, FLASH_ERASE_TIMEOUT);
+        status = FLASH_WaitForLastOperation(hflash, Deadline);
         CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_PER);
     }
 
@@ -481,39 +674,27 @@ static HAL_StatusTypeDef FLASH_Erase_Sector(FLASH_HandleTypeDef* hflash)
         return status;
     }
 
-    start = hflash->Flash_EraseAddress;
-    end = start + FLASH_PAGE_SIZE;
-    while (start < end)
-    {
-        if (*(__IO uint16_t *)start != 0xFFFFU)
-        {
-            hflash->ErrorCode |= HAL_FLASH_ERROR_PROG;
-            return HAL_ERROR;
-        }
-        start += 2U;
-    }
-
-    return HAL_OK;
+    return FLASH_CheckErased(hflash, hflash->Flash_EraseAddress, hflash->Flash_EraseAddress + FLASH_PAGE_SIZE);
 }
 
 /**
   * @brief  Erase mass memory.
   * @param  hflash  Flash handle instance.
+  * @param  Deadline Deadline of the whole operation.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-static HAL_StatusTypeDef FLASH_Erase_Mass(FLASH_HandleTypeDef* hflash)
+static HAL_StatusTypeDef FLASH_Erase_Mass(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline)
 {
     HAL_StatusTypeDef status;
-    uint32_t start;
 
-    status = FLASH_WaitForLastOperation(hflash, FLASH_ERASE_TIMEOUT);
+    status = FLASH_WaitForLastOperation(hflash, Deadline);
 
     if (status == HAL_OK)
     {
         SET_BIT(FLASH->CTLR,FLASH_CTLR_MER);
         SET_BIT(FLASH->CTLR,FLASH_CTLR_STRT);
-        status = FLASH_WaitForLastOperation(hflash, FLASH_ERASE_TIMEOUT);
+        status = FLASH_WaitForLastOperation(hflash, Deadline);
         CLEAR_BIT(FLASH->CTLR, FLASH_CTLR_MER);
     }
 
@@ -522,42 +703,24 @@ static HAL_StatusTypeDef FLASH_Erase_Mass(FLASH_HandleTypeDef* hflash)
         return status;
     }
 
-    start = VALID_ADDR_START;
-    while (start < VALID_ADDR_END)
-    {
-        if (*(__IO uint16_t *)start != 0xFFFFU)
-        {
-            hflash->ErrorCode |= HAL_FLASH_ERROR_PROG;
-            return HAL_ERROR;
-        }
-        start += 2U;
-    }
-
-    return HAL_OK;
+    return FLASH_CheckErased(hflash, VALID_ADDR_START, VALID_ADDR_END);
 }
 
 /**
   * @brief  Waits for a Flash operation to complete or a TIMEOUT to occur.
   * @param  hflash  Flash handle instance.
-  * @param  Timeout FLASH programming Timeout.
+  * @param  Deadline Deadline of the whole operation.
   *
   * @retval HAL_StatusTypeDef HAL Status
   */
-static HAL_StatusTypeDef FLASH_WaitForLastOperation(FLASH_HandleTypeDef* hflash, uint32_t Timeout)
+static HAL_StatusTypeDef FLASH_WaitForLastOperation(FLASH_HandleTypeDef* hflash, const HAL_DeadlineTypeDef *Deadline)
 {
-    uint32_t tickstart;
-
-    tickstart = HAL_GetTick();
-
     while (__HAL_FLASH_GET_FLAG(FLASH_FLAG_BSY) != 0U)
     {
-        if (Timeout != HAL_MAX_DELAY)
+        if (HAL_DeadlineExpired(Deadline) != FALSE)
         {
-            if ((HAL_GetTick() - tickstart) > Timeout)
-            {
-                hflash->ErrorCode |= HAL_FLASH_ERROR_TIMEOUT;
-                return HAL_TIMEOUT;
-            }
+            hflash->ErrorCode |= HAL_FLASH_ERROR_TIMEOUT;
+            return HAL_TIMEOUT;
         }
     }
 
@@ -576,6 +739,29 @@ static HAL_StatusTypeDef FLASH_WaitForLastOperation(FLASH_HandleTypeDef* hflash,
     return HAL_OK;
 }
 
+/**
+  * @brief  Check that a flash range reads back erased.
+  * @param  hflash  Flash handle instance.
+  * @param  Start first address of the range.
+  * @param  End address just past the range.
+  *
+  * @retval HAL_StatusTypeDef HAL Status
+  */
+static HAL_StatusTypeDef FLASH_CheckErased(FLASH_HandleTypeDef* hflash, uint32_t Start, uint32_t End)
+{
+    while (Start < End)
+    {
+        if (*(__IO uint16_t *)Start != 0xFFFFU)
+        {
+            hflash->ErrorCode |= HAL_FLASH_ERROR_PROG;
+            return HAL_ERROR;
+        }
+        Start += 2U;
+    }
+
+    return HAL_OK;
+}
+
 /**
   * @brief  Get FLASH error code.
   * @param  hflash  Flash handle instance.
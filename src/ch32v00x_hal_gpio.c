@@ -12,12 +12,81 @@
 #include <ch32v00x_hal.h>
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+/* AFIO->PCFR1 remap fields */
+#define PCFR1_SPI1_RM              ((uint32_t)0x00000001)
+#define PCFR1_I2C1_RM              ((uint32_t)0x00000002)
+#define PCFR1_USART1_RM            ((uint32_t)0x00000004)
+#define PCFR1_TIM1_RM_Pos          6U
+#define PCFR1_TIM2_RM_Pos          8U
+#define PCFR1_PA12_RM              ((uint32_t)0x00008000)
+#define PCFR1_ADC_ETRGINJ_RM       ((uint32_t)0x00020000)
+#define PCFR1_ADC_ETRGREG_RM       ((uint32_t)0x00040000)
+#define PCFR1_USART1_RM1           ((uint32_t)0x00200000)
+#define PCFR1_I2C1_RM1             ((uint32_t)0x00400000)
+#define PCFR1_SWCFG_DISABLE        ((uint32_t)0x04000000)
+#define PCFR1_REMAP_Mask           ((uint32_t)0x076683C7)
+
+/* AFIO users: EXTI lines 0..7 mapped through EXTICR, remap in PCFR1 */
+#define GPIO_AFIO_REMAP            ((uint16_t)0x0100)
 /* Private macro -------------------------------------------------------------*/
+/* Pin identifier in the HAL_GPIO_Snapshot() layout */
+#define RM_PA(n)                   ((uint8_t)((GPIO_PortSourceGPIOA << 3) | (n)))
+#define RM_PC(n)                   ((uint8_t)((GPIO_PortSourceGPIOC << 3) | (n)))
+#define RM_PD(n)                   ((uint8_t)((GPIO_PortSourceGPIOD << 3) | (n)))
 /* Private variables ---------------------------------------------------------*/
+/* Pin of every AF signal for each remap set, indexed by GPIO_AF_xxx bit position */
+static const uint8_t GPIO_RemapPins[GPIO_AF_SIGNAL_COUNT][4] =
+{
+    { RM_PD(4), RM_PD(7), RM_PD(7), RM_PC(5) },  /* USART1_CK   */
+    { RM_PD(5), RM_PD(0), RM_PD(6), RM_PC(0) },  /* USART1_TX   */
+    { RM_PD(6), RM_PD(1), RM_PD(5), RM_PC(1) },  /* USART1_RX   */
+    { RM_PD(3), RM_PC(3), RM_PC(6), RM_PC(6) },  /* USART1_CTS  */
+    { RM_PC(2), RM_PC(2), RM_PC(7), RM_PC(7) },  /* USART1_RTS  */
+    { RM_PC(1), RM_PC(0), RM_PC(0), RM_PC(0) },  /* SPI1_NSS    */
+    { RM_PC(5), RM_PC(5), RM_PC(5), RM_PC(5) },  /* SPI1_SCK    */
+    { RM_PC(7), RM_PC(7), RM_PC(7), RM_PC(7) },  /* SPI1_MISO   */
+    { RM_PC(6), RM_PC(6), RM_PC(6), RM_PC(6) },  /* SPI1_MOSI   */
+    { RM_PC(2), RM_PD(1), RM_PC(5), RM_PC(5) },  /* I2C1_SCL    */
+    { RM_PC(1), RM_PD(0), RM_PC(6), RM_PC(6) },  /* I2C1_SDA    */
+    { RM_PC(5), RM_PC(5), RM_PD(4), RM_PC(2) },  /* TIM1_ETR    */
+    { RM_PD(2), RM_PC(6), RM_PD(2), RM_PC(4) },  /* TIM1_CH1    */
+    { RM_PA(1), RM_PC(7), RM_PA(1), RM_PC(7) },  /* TIM1_CH2    */
+    { RM_PC(3), RM_PC(0), RM_PC(3), RM_PC(5) },  /* TIM1_CH3    */
+    { RM_PC(4), RM_PD(3), RM_PC(4), RM_PD(4) },  /* TIM1_CH4    */
+    { RM_PC(2), RM_PC(1), RM_PC(2), RM_PC(1) },  /* TIM1_BKIN   */
+    { RM_PD(0), RM_PC(3), RM_PD(0), RM_PC(3) },  /* TIM1_CH1N   */
+    { RM_PA(2), RM_PC(4), RM_PA(2), RM_PD(2) },  /* TIM1_CH2N   */
+    { RM_PD(1), RM_PD(1), RM_PD(1), RM_PC(6) },  /* TIM1_CH3N   */
+    { RM_PD(4), RM_PC(5), RM_PC(1), RM_PC(1) },  /* TIM2_CH1    */
+    { RM_PD(3), RM_PC(2), RM_PD(3), RM_PC(7) },  /* TIM2_CH2    */
+    { RM_PC(0), RM_PD(2), RM_PC(0), RM_PD(6) },  /* TIM2_CH3    */
+    { RM_PD(7), RM_PC(1), RM_PD(7), RM_PD(5) },  /* TIM2_CH4    */
+    { RM_PC(4), RM_PC(4), RM_PC(4), RM_PC(4) },  /* MCO         */
+};
+
+static pGPIO_EXTICallbackTypeDef GPIO_EXTICallback[8];
+static void *GPIO_EXTIContext[8];
+
+/* Port clocks, indexed like GPIO_PinsHeld */
+static const uint32_t GPIO_PortClock[GPIO_PORT_COUNT] =
+{
+    RCC_APB2Periph_GPIOA, RCC_APB2Periph_GPIOC, RCC_APB2Periph_GPIOD
+};
+/* Pins configured through this module, the port clock is held while not zero */
+static uint8_t GPIO_PinsHeld[GPIO_PORT_COUNT];
+/* AFIO users, the AFIO clock is held while not zero */
+static uint16_t GPIO_AFIOUsers = 0;
 /* Private function prototypes -----------------------------------------------*/
+static inline uint32_t GPIO_LowestLine(uint32_t Pending);
+static uint32_t GPIO_PortIndex(GPIO_TypeDef *GPIOx);
+static void GPIO_PortHold(GPIO_TypeDef *GPIOx, uint8_t Hold, uint8_t Drop);
+static void GPIO_AFIOHold(uint16_t Hold, uint16_t Drop);
+static uint32_t GPIO_NsToCycles(uint32_t Ns);
 /* Exported functions ---------------------------------------------------------*/
 /**
   * @brief  Initializes the GPIOx peripheral according to the specified parameters in the GPIO_InitStruct.
+  * @note   The port clock is enabled and held until every configured pin of
+  *         the port has been returned with HAL_GPIO_DeInit().
   * @param  GPIOx where x can be (A..D).
   * @param  GPIO_InitStruct pointer to a GPIO_InitTypeDef structure that contains
   *         the configuration information for the specified GPIO peripheral.
@@ -42,6 +111,10 @@ void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct)
         currentmode |= (uint32_t)GPIO_InitStruct->GPIO_Speed;
     }
 
+    HAL_BOOT_PHASE_BEGIN(RCC_BOOT_PHASE_GPIO);
+
+    GPIO_PortHold(GPIOx, (uint8_t)GPIO_InitStruct->GPIO_Pin, 0U);
+
     if (((uint32_t)GPIO_InitStruct->GPIO_Pin & ((uint32_t)0x00FF)) != 0x00)
     {
         tmpreg = READ_REG(GPIOx->CFGLR);
@@ -74,6 +147,187 @@ void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct)
 
         WRITE_REG(GPIOx->CFGLR, tmpreg);
     }
+
+    HAL_BOOT_PHASE_END(RCC_BOOT_PHASE_GPIO);
+}
+
+/**
+  * @brief  Returns pins to their reset state (floating input, OUTDR bit cleared).
+  * @note   The port clock is released with the last pin configured through
+  *         this module.
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_Pin any combination of GPIO_Pin_x where x can be (0..7).
+  * @retval None
+  */
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
+    HAL_PARAM_CHECK(IS_GPIO_PIN_MASK(GPIO_Pin));
+
+    uint32_t cfg_mask = 0x00, cfg_value = 0x00, pinpos = 0x00;
+
+    for (pinpos = 0x00; pinpos < 0x08; pinpos++)
+    {
+        if ((GPIO_Pin & (0x01U << pinpos)) != 0x00)
+        {
+            cfg_mask |= HAL_GPIO_CFG_MASK(pinpos);
+            cfg_value |= HAL_GPIO_CFG_PIN(pinpos, GPIO_Mode_IN_FLOATING, 0U);
+        }
+    }
+
+    MODIFY_REG(GPIOx->CFGLR, cfg_mask, cfg_value);
+    WRITE_REG(GPIOx->BCR, GPIO_Pin);
+
+    GPIO_PortHold(GPIOx, 0U, (uint8_t)GPIO_Pin);
+}
+
+/**
+  * @brief  Initializes all the board pins from a constant configuration table.
+  * @note   Entries are merged per port first, then each port gets one OUTDR
+  *         update followed by one CFGLR write (see HAL_GPIO_ApplyPortConfig).
+  *         Later entries override earlier ones for the same pin.
+  * @param  Table pointer to an array of GPIO_PinConfigTypeDef.
+  * @param  Count number of entries in Table.
+  * @retval None
+  */
+void HAL_GPIO_InitTable(const GPIO_PinConfigTypeDef *Table, uint16_t Count)
+{
+    GPIO_PortConfigTypeDef port_config[GPIO_PORT_COUNT];
+    uint8_t nb_ports = 0x00;
+
+    HAL_BOOT_PHASE_BEGIN(RCC_BOOT_PHASE_GPIO);
+
+    HAL_GPIO_MergeTable(Table, Count, port_config, &nb_ports);
+    HAL_GPIO_ApplyPortConfig(port_config, nb_ports);
+
+    HAL_BOOT_PHASE_END(RCC_BOOT_PHASE_GPIO);
+}
+
+/**
+  * @brief  Merges a pin configuration table into one configuration per port.
+  * @note   The result can be dumped once and kept as a const table, so that
+  *         the board init is reduced to HAL_GPIO_ApplyPortConfig.
+  * @param  Table pointer to an array of GPIO_PinConfigTypeDef.
+  * @param  Count number of entries in Table.
+  * @param  PortConfig array of at least GPIO_PORT_COUNT elements receiving the result.
+  * @param  NbPorts receives the number of ports filled in PortConfig.
+  * @retval None
+  */
+void HAL_GPIO_MergeTable(const GPIO_PinConfigTypeDef *Table, uint16_t Count,
+                         GPIO_PortConfigTypeDef *PortConfig, uint8_t *NbPorts)
+{
+    GPIO_PortConfigTypeDef *cfg;
+    uint32_t nibble = 0x00, pinmask = 0x00, pinpos = 0x00;
+    uint16_t level = 0x00;
+    uint8_t idx = 0x00, nb = 0x00;
+
+    for (; Count > 0U; Count--, Table++)
+    {
+        /* Check the parameters */
+        HAL_PARAM_CHECK(IS_GPIO_INSTANCE(Table->Port));
+        HAL_PARAM_CHECK(IS_GPIO_PIN_MASK(Table->Pin));
+        HAL_PARAM_CHECK(IS_GPIO_MODE(Table->Mode));
+
+        /* Find or open the port slot */
+        for (idx = 0x00; (idx < nb) && (PortConfig[idx].Port != Table->Port); idx++)
+        {
+        }
+
+        cfg = &PortConfig[idx];
+
+        if (idx == nb)
+        {
+            cfg->Port = Table->Port;
+            cfg->CfgMask = 0x00;
+            cfg->CfgValue = 0x00;
+            cfg->OutMask = 0x00;
+            cfg->OutValue = 0x00;
+            nb++;
+        }
+
+        nibble = HAL_GPIO_CFG_NIBBLE(Table->Mode, Table->Speed);
+
+        /* Pull direction goes through OUTDR like the output level,
+           analog and floating inputs leave OUTDR untouched */
+        if ((Table->Mode == GPIO_Mode_IPU) ||
+            (!IS_GPIO_INPUT(Table->Mode) && (Table->Level != GPIO_PIN_RESET)))
+        {
+            level = 0xFFFF;
+        }
+        else
+        {
+            level = 0x00;
+        }
+
+        if ((Table->Mode == GPIO_Mode_IPU) || (Table->Mode == GPIO_Mode_IPD) || !IS_GPIO_INPUT(Table->Mode))
+        {
+            cfg->OutMask |= Table->Pin;
+            cfg->OutValue = (uint16_t)((cfg->OutValue & ~Table->Pin) | (level & Table->Pin));
+        }
+
+        for (pinpos = 0x00; pinpos < 0x08; pinpos++)
+        {
+            if ((Table->Pin & (0x01U << pinpos)) != 0x00)
+            {
+                pinmask = HAL_GPIO_CFG_MASK(pinpos);
+                cfg->CfgMask |= pinmask;
+                cfg->CfgValue = (cfg->CfgValue & ~pinmask) | (nibble << (pinpos << 2));
+            }
+        }
+    }
+
+    *NbPorts = nb;
+}
+
+/**
+  * @brief  Applies precomputed port configurations.
+  * @note   Output levels and pulls are written first with one BSHR store so
+  *         that outputs never drive the wrong level, then CFGLR is written
+  *         once (plain write when every nibble is owned, read-modify-write
+  *         otherwise). The clock of each port is held as by HAL_GPIO_Init().
+  * @param  PortConfig pointer to an array of GPIO_PortConfigTypeDef.
+  * @param  NbPorts number of entries in PortConfig.
+  * @retval None
+  */
+void HAL_GPIO_ApplyPortConfig(const GPIO_PortConfigTypeDef *PortConfig, uint8_t NbPorts)
+{
+    GPIO_TypeDef *GPIOx;
+    uint32_t pinpos = 0x00;
+    uint8_t pins = 0x00;
+
+    for (; NbPorts > 0U; NbPorts--, PortConfig++)
+    {
+        /* Check the parameters */
+        HAL_PARAM_CHECK(IS_GPIO_INSTANCE(PortConfig->Port));
+
+        GPIOx = PortConfig->Port;
+        pins = (uint8_t)PortConfig->OutMask;
+
+        for (pinpos = 0x00; pinpos < 0x08; pinpos++)
+        {
+            if ((PortConfig->CfgMask & HAL_GPIO_CFG_MASK(pinpos)) != 0x00)
+            {
+                pins |= (uint8_t)(0x01U << pinpos);
+            }
+        }
+
+        GPIO_PortHold(GPIOx, pins, 0U);
+
+        if (PortConfig->OutMask != 0x00)
+        {
+            HAL_GPIO_FastWritePort(GPIOx, PortConfig->OutMask, PortConfig->OutValue);
+        }
+
+        if (PortConfig->CfgMask == 0xFFFFFFFFU)
+        {
+            WRITE_REG(GPIOx->CFGLR, PortConfig->CfgValue);
+        }
+        else if (PortConfig->CfgMask != 0x00)
+        {
+            MODIFY_REG(GPIOx->CFGLR, PortConfig->CfgMask, PortConfig->CfgValue);
+        }
+    }
 }
 
 /**
@@ -174,14 +428,361 @@ void HAL_GPIO_Toggle(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
     HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
     HAL_PARAM_CHECK(IS_GPIO_PIN(GPIO_Pin));
 
-    if (IS_BIT_CLR(GPIOx->OUTDR, GPIO_Pin))
+    HAL_GPIO_FastToggle(GPIOx, GPIO_Pin);
+}
+
+/**
+  * @brief  Writes several pins of a port at once.
+  * @note   All the pins selected by Mask change on the same bus cycle, there
+  *         is no intermediate state visible on the port.
+  * @param  GPIOx where x can be (A..D).
+  * @param  Mask pins to update, any combination of GPIO_Pin_x where x can be (0..7).
+  * @param  Value new level of the pins, bits outside Mask are ignored.
+  * @retval None
+  */
+void HAL_GPIO_WritePort(GPIO_TypeDef *GPIOx, uint16_t Mask, uint16_t Value)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
+    HAL_PARAM_CHECK(IS_GPIO_PIN_MASK(Mask));
+
+    HAL_GPIO_FastWritePort(GPIOx, Mask, Value);
+}
+
+/**
+  * @brief  Reads the whole input port.
+  * @param  GPIOx where x can be (A..D).
+  * @retval Input level of pins 0..7.
+  */
+uint16_t HAL_GPIO_ReadPort(GPIO_TypeDef *GPIOx)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
+
+    return HAL_GPIO_FastReadPort(GPIOx);
+}
+
+/**
+  * @brief  Reads the inputs of every port in one call.
+  * @note   Three INDR loads, see GPIO_SNAPSHOT_PINS for the bit layout.
+  * @retval Packed input levels.
+  */
+uint32_t HAL_GPIO_Snapshot(void)
+{
+    return GPIO_SNAPSHOT_PINS(GPIO_PortSourceGPIOA, READ_REG(GPIOA->INDR)) |
+           GPIO_SNAPSHOT_PINS(GPIO_PortSourceGPIOC, READ_REG(GPIOC->INDR)) |
+           GPIO_SNAPSHOT_PINS(GPIO_PortSourceGPIOD, READ_REG(GPIOD->INDR));
+}
+
+/**
+  * @brief  Starts a change detector from the current input levels.
+  * @param  hcd pointer to a GPIO_ChangeDetectTypeDef.
+  * @param  Mask snapshot bits to watch, built with GPIO_SNAPSHOT_PINS.
+  * @retval None
+  */
+void HAL_GPIO_ChangeInit(GPIO_ChangeDetectTypeDef *hcd, uint32_t Mask)
+{
+    hcd->Mask = Mask;
+    hcd->Last = HAL_GPIO_Snapshot() & Mask;
+}
+
+/**
+  * @brief  Takes a snapshot and reports the watched pins that changed since
+  *         the previous call.
+  * @param  hcd pointer to a GPIO_ChangeDetectTypeDef.
+  * @param  Snapshot receives the watched bits of the new snapshot, may be NULL.
+  * @retval Mask of changed pins, in the snapshot layout.
+  */
+uint32_t HAL_GPIO_ChangeDetect(GPIO_ChangeDetectTypeDef *hcd, uint32_t *Snapshot)
+{
+    uint32_t now = HAL_GPIO_Snapshot() & hcd->Mask;
+    uint32_t changed = now ^ hcd->Last;
+
+    hcd->Last = now;
+
+    if (Snapshot != NULL)
     {
-        WRITE_REG(GPIOx->BSHR, GPIO_Pin);
+        *Snapshot = now;
+    }
+
+    return changed;
+}
+
+/**
+  * @brief  Checks a key matrix description and releases all its rows.
+  * @note   Rows and columns must have been configured with HAL_GPIO_Init()
+  *         or HAL_GPIO_InitTable(), which hold the port clocks.
+  * @param  hkp pointer to a GPIO_KeypadTypeDef.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_GPIO_KeypadInit(GPIO_KeypadTypeDef *hkp)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(hkp->RowPort));
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(hkp->ColPort));
+    HAL_PARAM_CHECK((hkp->RowPins != 0U) && IS_GPIO_PIN_MASK(hkp->RowPins));
+    HAL_PARAM_CHECK((hkp->ColPins != 0U) && IS_GPIO_PIN_MASK(hkp->ColPins));
+
+    uint32_t rows = 0x00, cols = 0x00, pins = 0x00;
+
+    for (pins = hkp->RowPins; pins != 0U; pins &= pins - 1U) { rows++; }
+    for (pins = hkp->ColPins; pins != 0U; pins &= pins - 1U) { cols++; }
+
+    if ((rows * cols) > 32U)
+    {
+        return HAL_ERROR;
+    }
+
+    hkp->State = 0x00;
+    HAL_GPIO_FastSet(hkp->RowPort, hkp->RowPins);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Scans a key matrix.
+  * @note   Each row costs one BSHR store and one INDR load, rows are released
+  *         again at the end of the scan.
+  * @param  hkp pointer to an initialized GPIO_KeypadTypeDef.
+  * @param  Changed receives the keys that changed since the previous scan, may be NULL.
+  * @retval Keys pressed, bit (row * columns + column).
+  */
+uint32_t HAL_GPIO_KeypadScan(GPIO_KeypadTypeDef *hkp, uint32_t *Changed)
+{
+    GPIO_TypeDef *row_port = hkp->RowPort;
+    GPIO_TypeDef *col_port = hkp->ColPort;
+    uint32_t row_pins = hkp->RowPins;
+    uint32_t col_pins = hkp->ColPins;
+    uint32_t rows = 0x00, cols = 0x00, row = 0x00, low = 0x00, col = 0x00;
+    uint32_t pressed = 0x00, key = 0x00;
+
+    for (rows = row_pins; rows != 0U; rows &= rows - 1U)
+    {
+        row = rows & (0U - rows);
+
+        /* Selected row low, every other row released, in one store */
+        HAL_GPIO_FastWritePort(row_port, (uint16_t)row_pins, (uint16_t)(row_pins & ~row));
+
+        if (hkp->SettleUs != 0U)
+        {
+            HAL_DelayUs(hkp->SettleUs);
+        }
+
+        low = ~READ_REG(col_port->INDR) & col_pins;
+
+        for (cols = col_pins; cols != 0U; cols &= cols - 1U, key++)
+        {
+            col = cols & (0U - cols);
+
+            if ((low & col) != 0U)
+            {
+                pressed |= 1UL << key;
+            }
+        }
+    }
+
+    HAL_GPIO_FastSet(row_port, (uint16_t)row_pins);
+
+    if (Changed != NULL)
+    {
+        *Changed = pressed ^ hkp->State;
+    }
+
+    hkp->State = pressed;
+
+    return pressed;
+}
+
+/**
+  * @brief  Writes one data word on a parallel bus and pulses its strobe.
+  * @param  hbus pointer to a GPIO_BusTypeDef describing the bus.
+  * @param  Data value to put on the bus, only DataWidth bits are used.
+  * @retval None
+  */
+void HAL_GPIO_BusWrite(const GPIO_BusTypeDef *hbus, uint8_t Data)
+{
+    HAL_GPIO_BusWriteBuffer(hbus, &Data, 1U);
+}
+
+/**
+  * @brief  Writes a buffer on a parallel bus, one strobe pulse per element.
+  * @note   Data lines are updated with a single store, the strobe is asserted
+  *         by a separate store once SetupNs has elapsed and held for PulseNs.
+  *         Both times are minimums measured on SysTick, which must be running
+  *         when they are not zero.
+  * @param  hbus pointer to a GPIO_BusTypeDef describing the bus.
+  * @param  pData pointer to data buffer.
+  * @param  Size amount of data elements to be written.
+  * @retval None
+  */
+void HAL_GPIO_BusWriteBuffer(const GPIO_BusTypeDef *hbus, const uint8_t *pData, uint16_t Size)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(hbus->DataPort));
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(hbus->StrobePort));
+    HAL_PARAM_CHECK(IS_GPIO_BUS(hbus->DataShift, hbus->DataWidth));
+    HAL_PARAM_CHECK(IS_GPIO_BUS_STROBE(hbus));
+
+    GPIO_TypeDef *data_port = hbus->DataPort;
+    GPIO_TypeDef *strobe_port = hbus->StrobePort;
+    uint32_t mask = ((1UL << hbus->DataWidth) - 1UL) << hbus->DataShift;
+    uint32_t strobe = hbus->StrobePin;
+    uint32_t setup = GPIO_NsToCycles(hbus->SetupNs);
+    uint32_t pulse = GPIO_NsToCycles(hbus->PulseNs);
+    uint32_t assert_word = 0x00, release_word = 0x00;
+    uint32_t word;
+
+    /* BSHR words asserting / releasing the strobe */
+    if (hbus->StrobeActive != GPIO_PIN_RESET)
+    {
+        assert_word = strobe;
+        release_word = strobe << 16U;
     }
     else
     {
-        WRITE_REG(GPIOx->BCR, GPIO_Pin);
+        assert_word = strobe << 16U;
+        release_word = strobe;
+    }
+
+    while (Size-- > 0U)
+    {
+        word = (uint32_t)(*pData++) << hbus->DataShift;
+        word = ((~word & mask) << 16U) | (word & mask);
+
+        WRITE_REG(data_port->BSHR, word);
+        HAL_DelayCycles(setup);
+        WRITE_REG(strobe_port->BSHR, assert_word);
+        HAL_DelayCycles(pulse);
+        WRITE_REG(strobe_port->BSHR, release_word);
+    }
+}
+
+/**
+  * @brief  Pulses the strobe of a parallel bus and samples the data lines.
+  * @note   The data lines must have been configured as inputs. They are
+  *         sampled PulseNs after the strobe active edge, SysTick must be
+  *         running when PulseNs is not zero.
+  * @param  hbus pointer to a GPIO_BusTypeDef describing the bus.
+  * @retval Value read on the bus.
+  */
+uint8_t HAL_GPIO_BusRead(const GPIO_BusTypeDef *hbus)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(hbus->DataPort));
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(hbus->StrobePort));
+    HAL_PARAM_CHECK(IS_GPIO_BUS(hbus->DataShift, hbus->DataWidth));
+    HAL_PARAM_CHECK(IS_GPIO_BUS_STROBE(hbus));
+
+    uint32_t mask = (1UL << hbus->DataWidth) - 1UL;
+    uint32_t pulse = GPIO_NsToCycles(hbus->PulseNs);
+    uint32_t data;
+
+    HAL_GPIO_FastWrite(hbus->StrobePort, hbus->StrobePin, hbus->StrobeActive);
+    HAL_DelayCycles(pulse);
+    data = READ_REG(hbus->DataPort->INDR);
+    HAL_GPIO_FastWrite(hbus->StrobePort, hbus->StrobePin,
+                       (hbus->StrobeActive != GPIO_PIN_RESET) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+
+    return (uint8_t)((data >> hbus->DataShift) & mask);
+}
+
+/**
+  * @brief  Checks that no pin is claimed twice by a remap configuration.
+  * @note   Only the signals listed in Remap->Signals are placed, plus PA1/PA2
+  *         for the crystal and PD1 while SWD is kept enabled.
+  * @param  Remap pointer to a GPIO_RemapTypeDef.
+  * @param  Conflicts receives the pins claimed more than once, in the
+  *         HAL_GPIO_Snapshot() layout, may be NULL.
+  * @retval HAL_OK if every pin has at most one owner, HAL_ERROR otherwise.
+  */
+HAL_StatusTypeDef HAL_GPIO_RemapCheck(const GPIO_RemapTypeDef *Remap, uint32_t *Conflicts)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_REMAP(Remap));
+
+    uint32_t used = 0x00, conflicts = 0x00, pin = 0x00;
+    uint32_t signals = Remap->Signals;
+    uint8_t index = 0x00, set = 0x00;
+
+    if (Remap->Osc != DISABLE)
+    {
+        used = (1UL << RM_PA(1)) | (1UL << RM_PA(2));
+    }
+
+    if (Remap->SwdDisable == DISABLE)
+    {
+        pin = 1UL << RM_PD(1);
+        conflicts |= used & pin;
+        used |= pin;
+    }
+
+    for (index = 0x00; (signals != 0U) && (index < GPIO_AF_SIGNAL_COUNT); index++, signals >>= 1)
+    {
+        if ((signals & 0x01U) == 0U)
+        {
+            continue;
+        }
+
+        if (index < 5U)       { set = Remap->Usart1; }
+        else if (index < 9U)  { set = Remap->Spi1; }
+        else if (index < 11U) { set = Remap->I2c1; }
+        else if (index < 20U) { set = Remap->Tim1; }
+        else if (index < 24U) { set = Remap->Tim2; }
+        else                  { set = 0U; }
+
+        pin = 1UL << GPIO_RemapPins[index][set];
+        conflicts |= used & pin;
+        used |= pin;
+    }
+
+    if (Conflicts != NULL)
+    {
+        *Conflicts = conflicts;
     }
+
+    return (conflicts == 0U) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+  * @brief  Applies a whole-chip remap configuration.
+  * @note   The configuration is checked first and nothing is written when two
+  *         signals claim the same pin. Every remap field of AFIO->PCFR1 is then
+  *         updated with a single write. The AFIO clock is held while any
+  *         remap field is set.
+  * @param  Remap pointer to a GPIO_RemapTypeDef.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_GPIO_RemapConfig(const GPIO_RemapTypeDef *Remap)
+{
+    uint32_t pcfr1 = 0x00;
+
+    if (HAL_GPIO_RemapCheck(Remap, NULL) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    if (Remap->Spi1 != GPIO_REMAP_SPI1_0)          { pcfr1 |= PCFR1_SPI1_RM; }
+    if (Remap->I2c1 == GPIO_REMAP_I2C1_1)          { pcfr1 |= PCFR1_I2C1_RM; }
+    if (Remap->I2c1 == GPIO_REMAP_I2C1_2)          { pcfr1 |= PCFR1_I2C1_RM1; }
+    if ((Remap->Usart1 & 0x01U) != 0U)             { pcfr1 |= PCFR1_USART1_RM; }
+    if ((Remap->Usart1 & 0x02U) != 0U)             { pcfr1 |= PCFR1_USART1_RM1; }
+    if (Remap->Osc != DISABLE)                     { pcfr1 |= PCFR1_PA12_RM; }
+    if (Remap->SwdDisable != DISABLE)              { pcfr1 |= PCFR1_SWCFG_DISABLE; }
+    if ((Remap->AdcTrigger & GPIO_REMAP_ADC_ETRGINJ) != 0U) { pcfr1 |= PCFR1_ADC_ETRGINJ_RM; }
+    if ((Remap->AdcTrigger & GPIO_REMAP_ADC_ETRGREG) != 0U) { pcfr1 |= PCFR1_ADC_ETRGREG_RM; }
+
+    pcfr1 |= (uint32_t)Remap->Tim1 << PCFR1_TIM1_RM_Pos;
+    pcfr1 |= (uint32_t)Remap->Tim2 << PCFR1_TIM2_RM_Pos;
+
+    GPIO_AFIOHold(GPIO_AFIO_REMAP, 0U);
+    MODIFY_REG(AFIO->PCFR1, PCFR1_REMAP_Mask, pcfr1);
+
+    if (pcfr1 == 0U)
+    {
+        GPIO_AFIOHold(0U, GPIO_AFIO_REMAP);
+    }
+
+    return HAL_OK;
 }
 
 /**
@@ -211,6 +812,8 @@ void HAL_GPIO_PinLockConfig(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
 
 /**
   * @brief  Selects the GPIO pin used as EXTI Line.
+  * @note   The AFIO clock is held until the line is masked in both interrupt
+  *         and event mode by HAL_GPIO_EXTI_Disable().
   * @param  GPIO_PortSource selects the GPIO port to be used as source for EXTI lines.
   *          This parameter can be GPIO_PortSourceGPIOx where x can be (A..D).
   * @param  GPIO_PinSource specifies the EXTI line to be configured.
@@ -223,11 +826,145 @@ void HAL_GPIO_EXTILineConfig(uint8_t GPIO_PortSource, uint8_t GPIO_PinSource)
     HAL_PARAM_CHECK(IS_GPIO_PORT_SOURCE(GPIO_PortSource));
     HAL_PARAM_CHECK(IS_GPIO_PIN_SOURCE(GPIO_PinSource));
 
-    uint32_t tmp = 0x00;
+    GPIO_AFIOHold((uint16_t)(0x01U << GPIO_PinSource), 0U);
+    MODIFY_REG(AFIO->EXTICR, (uint32_t)0x03U << (GPIO_PinSource << 1),
+               (uint32_t)GPIO_PortSource << (GPIO_PinSource << 1));
+}
+
+/**
+  * @brief  Configures port mapping, trigger edges and mode of several EXTI lines.
+  * @note   All the lines are routed with a single EXTICR update, then each of
+  *         RTENR, FTENR, INTFR, INTENR and EVENR is written once. Pending
+  *         flags of the lines are cleared before they are unmasked. The AFIO
+  *         clock is held as by HAL_GPIO_EXTILineConfig() unless no mode is
+  *         selected.
+  * @param  Config pointer to a GPIO_EXTIConfigTypeDef.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_GPIO_EXTI_Config(const GPIO_EXTIConfigTypeDef *Config)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_LINES(Config->Lines));
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_TRIGGER(Config->Trigger));
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_MODE(Config->Mode));
+
+    uint32_t lines = Config->Lines;
+    uint32_t gpio_lines = lines & GPIO_EXTI_LINES_MASK;
+    uint32_t cr_mask = 0x00, cr_value = 0x00, pinpos = 0x00;
+    uint32_t ms;
+
+    if (gpio_lines != 0x00)
+    {
+        HAL_PARAM_CHECK(IS_GPIO_PORT_SOURCE(Config->PortSource));
+
+        for (pinpos = 0x00; pinpos < 0x08; pinpos++)
+        {
+            if ((gpio_lines & (0x01U << pinpos)) != 0x00)
+            {
+                cr_mask |= (uint32_t)0x03U << (pinpos << 1);
+                cr_value |= (uint32_t)Config->PortSource << (pinpos << 1);
+            }
+        }
+    }
+
+    ms = _irq_lock();
+
+    if (cr_mask != 0x00)
+    {
+        GPIO_AFIOHold((uint16_t)gpio_lines, 0U);
+        MODIFY_REG(AFIO->EXTICR, cr_mask, cr_value);
+    }
+
+    MODIFY_REG(EXTI->RTENR, lines, ((Config->Trigger & GPIO_EXTI_TRIGGER_RISING) != 0U) ? lines : 0U);
+    MODIFY_REG(EXTI->FTENR, lines, ((Config->Trigger & GPIO_EXTI_TRIGGER_FALLING) != 0U) ? lines : 0U);
+    WRITE_REG(EXTI->INTFR, lines);
+    MODIFY_REG(EXTI->INTENR, lines, ((Config->Mode & GPIO_EXTI_MODE_IT) != 0U) ? lines : 0U);
+    MODIFY_REG(EXTI->EVENR, lines, ((Config->Mode & GPIO_EXTI_MODE_EVT) != 0U) ? lines : 0U);
+
+    if (Config->Mode == 0U)
+    {
+        GPIO_AFIOHold(0U, (uint16_t)gpio_lines);
+    }
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Unmasks several EXTI lines at once.
+  * @param  Lines EXTI lines, any combination of GPIO_Pin_x where x can be (0..7)
+  *         and GPIO_EXTI_LINE_PVD / GPIO_EXTI_LINE_AWU.
+  * @param  Mode any combination of @ref GPIO_EXTI_Mode.
+  * @retval None
+  */
+void HAL_GPIO_EXTI_Enable(uint16_t Lines, uint8_t Mode)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_LINES(Lines));
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_MODE(Mode));
+
+    uint32_t ms = _irq_lock();
+
+    if ((Mode & GPIO_EXTI_MODE_IT) != 0U)
+    {
+        SET_BIT(EXTI->INTENR, Lines);
+    }
+
+    if ((Mode & GPIO_EXTI_MODE_EVT) != 0U)
+    {
+        SET_BIT(EXTI->EVENR, Lines);
+    }
+
+    _irq_unlock(ms);
+}
+
+/**
+  * @brief  Masks several EXTI lines at once.
+  * @note   Lines 0..7 left masked in both modes give back their hold on the
+  *         AFIO clock.
+  * @param  Lines EXTI lines, any combination of GPIO_Pin_x where x can be (0..7)
+  *         and GPIO_EXTI_LINE_PVD / GPIO_EXTI_LINE_AWU.
+  * @param  Mode any combination of @ref GPIO_EXTI_Mode.
+  * @retval None
+  */
+void HAL_GPIO_EXTI_Disable(uint16_t Lines, uint8_t Mode)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_LINES(Lines));
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_MODE(Mode));
+
+    uint32_t ms = _irq_lock();
+
+    if ((Mode & GPIO_EXTI_MODE_IT) != 0U)
+    {
+        CLEAR_BIT(EXTI->INTENR, Lines);
+    }
+
+    if ((Mode & GPIO_EXTI_MODE_EVT) != 0U)
+    {
+        CLEAR_BIT(EXTI->EVENR, Lines);
+    }
+
+    GPIO_AFIOHold(0U, (uint16_t)(Lines & GPIO_EXTI_LINES_MASK & ~(READ_REG(EXTI->INTENR) | READ_REG(EXTI->EVENR))));
 
-    tmp = ((uint32_t)(3 << (GPIO_PinSource << 1)));
-    AFIO->EXTICR &= ~tmp;
-    AFIO->EXTICR |= ((uint32_t)(GPIO_PortSource << (GPIO_PinSource << 1)));
+    _irq_unlock(ms);
+}
+
+/**
+  * @brief  Triggers EXTI lines by software.
+  * @note   The lines behave as if their edge had been detected: pending flags
+  *         are set and unmasked interrupts / events are raised.
+  * @param  Lines EXTI lines, any combination of GPIO_Pin_x where x can be (0..7)
+  *         and GPIO_EXTI_LINE_PVD / GPIO_EXTI_LINE_AWU.
+  * @retval None
+  */
+void HAL_GPIO_EXTI_GenerateSWI(uint16_t Lines)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_EXTI_LINES(Lines));
+
+    WRITE_REG(EXTI->SWIEVR, Lines);
 }
 
 /**
@@ -263,3 +1000,189 @@ __weak void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
            the HAL_GPIO_EXTI_Callback could be implemented in the user file
    */
 }
+
+/**
+  * @brief  Attaches a callback to one EXTI line, served by HAL_GPIO_EXTI_Dispatch().
+  * @note   Lines without a registered callback fall back to HAL_GPIO_EXTI_Callback().
+  * @param  GPIO_PinSource EXTI line, GPIO_PinSourcex where x can be (0..7).
+  * @param  pCallback function called with the line pin and Context.
+  * @param  Context user pointer passed back to pCallback.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_GPIO_EXTI_RegisterCallback(uint8_t GPIO_PinSource, pGPIO_EXTICallbackTypeDef pCallback, void *Context)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_PIN_SOURCE(GPIO_PinSource));
+    HAL_PARAM_CHECK(pCallback != NULL);
+
+    uint32_t ms = _irq_lock();
+    GPIO_EXTIContext[GPIO_PinSource] = Context;
+    GPIO_EXTICallback[GPIO_PinSource] = pCallback;
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Detaches the callback of one EXTI line.
+  * @param  GPIO_PinSource EXTI line, GPIO_PinSourcex where x can be (0..7).
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_GPIO_EXTI_UnregisterCallback(uint8_t GPIO_PinSource)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_PIN_SOURCE(GPIO_PinSource));
+
+    uint32_t ms = _irq_lock();
+    GPIO_EXTICallback[GPIO_PinSource] = NULL;
+    GPIO_EXTIContext[GPIO_PinSource] = NULL;
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Serves every pending EXTI line 0..7 in one pass.
+  * @note   Pending flags are read once and acknowledged with a single INTFR
+  *         write, then lines are served from the lowest to the highest.
+  *         An edge arriving while callbacks run raises the IRQ again.
+  * @retval None
+  */
+void HAL_GPIO_EXTI_Dispatch(void)
+{
+    uint32_t pending = READ_REG(EXTI->INTFR) & READ_REG(EXTI->INTENR) & GPIO_EXTI_LINES_MASK;
+    uint32_t line = 0x00;
+    pGPIO_EXTICallbackTypeDef callback;
+
+    WRITE_REG(EXTI->INTFR, pending);
+
+    while (pending != 0x00)
+    {
+        line = GPIO_LowestLine(pending);
+        pending &= pending - 1U;
+
+        callback = GPIO_EXTICallback[line];
+
+        if (callback != NULL)
+        {
+            callback((uint16_t)(1U << line), GPIO_EXTIContext[line]);
+        }
+        else
+        {
+            HAL_GPIO_EXTI_Callback((uint16_t)(1U << line));
+        }
+    }
+}
+
+#ifdef HAL_GPIO_EXTI_DISPATCH
+/**
+  * @brief  ISR of EXTI lines 0..7, defined when HAL_GPIO_EXTI_DISPATCH is set.
+  * @retval None
+  */
+HAL_IRQ_FAST
+void EXTI7_0_IRQHandler(void)
+{
+    HAL_ISR_ENTER(EXTI7_0_IRQn);
+
+    HAL_GPIO_EXTI_Dispatch();
+
+    HAL_ISR_EXIT(EXTI7_0_IRQn);
+}
+#endif /* HAL_GPIO_EXTI_DISPATCH */
+
+/* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Count trailing zeros of a non zero 8-bit pending mask.
+  * @note   RV32EC has no ctz instruction and __builtin_ctz becomes a libgcc
+  *         call, three compare steps are enough for 8 lines.
+  * @param  Pending non zero EXTI pending mask.
+  * @retval Index of the lowest pending line.
+  */
+static inline uint32_t GPIO_LowestLine(uint32_t Pending)
+{
+    uint32_t line = 0x00;
+
+    if ((Pending & 0x0FU) == 0x00) { line += 4U; Pending >>= 4; }
+    if ((Pending & 0x03U) == 0x00) { line += 2U; Pending >>= 2; }
+    if ((Pending & 0x01U) == 0x00) { line += 1U; }
+
+    return line;
+}
+
+/**
+  * @brief  Converts a bus time to HCLK cycles, rounded up.
+  * @param  Ns duration in nanoseconds, at most 65535.
+  * @retval cycles
+  */
+static uint32_t GPIO_NsToCycles(uint32_t Ns)
+{
+    if (Ns == 0U)
+    {
+        return 0U;
+    }
+
+    /* HCLK is a multiple of 1 kHz, Ns * kHz stays below 2^32 up to 65 MHz */
+    return ((Ns * (HAL_RCC_GetHCLKFreq() / 1000U)) + 999999U) / 1000000U;
+}
+
+/**
+  * @brief  Index of a port in GPIO_PinsHeld and GPIO_PortClock.
+  * @param  GPIOx where x can be (A..D).
+  * @retval 0 for GPIOA, 1 for GPIOC, 2 for GPIOD.
+  */
+static uint32_t GPIO_PortIndex(GPIO_TypeDef *GPIOx)
+{
+    return (GPIOx == GPIOA) ? 0U : ((GPIOx == GPIOC) ? 1U : 2U);
+}
+
+/**
+  * @brief  Updates the pins owned on a port and holds its clock while any is.
+  * @param  GPIOx where x can be (A..D).
+  * @param  Hold pins configured by the caller.
+  * @param  Drop pins returned by the caller.
+  * @retval None
+  */
+static void GPIO_PortHold(GPIO_TypeDef *GPIOx, uint8_t Hold, uint8_t Drop)
+{
+    uint32_t index = GPIO_PortIndex(GPIOx);
+    uint32_t ms = _irq_lock();
+    uint8_t held = GPIO_PinsHeld[index];
+
+    GPIO_PinsHeld[index] = (uint8_t)((held | Hold) & ~Drop);
+
+    if ((held == 0U) && (GPIO_PinsHeld[index] != 0U))
+    {
+        (void)HAL_RCC_ClockAcquire(GPIO_PortClock[index], 0U);
+    }
+    else if ((held != 0U) && (GPIO_PinsHeld[index] == 0U))
+    {
+        (void)HAL_RCC_ClockRelease(GPIO_PortClock[index], 0U);
+    }
+
+    _irq_unlock(ms);
+}
+
+/**
+  * @brief  Updates the AFIO users and holds the AFIO clock while any is left.
+  * @param  Hold EXTI lines 0..7 being mapped and/or GPIO_AFIO_REMAP.
+  * @param  Drop EXTI lines 0..7 no longer used and/or GPIO_AFIO_REMAP.
+  * @retval None
+  */
+static void GPIO_AFIOHold(uint16_t Hold, uint16_t Drop)
+{
+    uint32_t ms = _irq_lock();
+    uint16_t users = GPIO_AFIOUsers;
+
+    GPIO_AFIOUsers = (uint16_t)((users | Hold) & ~Drop);
+
+    if ((users == 0U) && (GPIO_AFIOUsers != 0U))
+    {
+        (void)HAL_RCC_ClockAcquire(RCC_APB2Periph_AFIO, 0U);
+    }
+    else if ((users != 0U) && (GPIO_AFIOUsers == 0U))
+    {
+        (void)HAL_RCC_ClockRelease(RCC_APB2Periph_AFIO, 0U);
+    }
+
+    _irq_unlock(ms);
+}
@@ -0,0 +1,489 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : ch32v00x_hal_input.c
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : Input engine driver.
+ *                      This file provides edge timestamping, debouncing and
+ *                      quadrature decoding on top of the EXTI dispatcher
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+/* Includes ------------------------------------------------------------------*/
+#include <ch32v00x_hal.h>
+/* Private typedef -----------------------------------------------------------*/
+/* Role of an EXTI line */
+typedef enum
+{
+    INPUT_LINE_UNUSED    = 0x00U,
+    INPUT_LINE_BUTTON    = 0x01U,
+    INPUT_LINE_ENCODER_A = 0x02U,
+    INPUT_LINE_ENCODER_B = 0x03U
+} INPUT_LineRoleTypeDef;
+
+/* State of one EXTI line */
+typedef struct
+{
+    GPIO_TypeDef *Port;       /* Port routed to the line */
+
+    uint32_t FirstEdge;       /* Button: cycle stamp of the first edge of the window */
+
+    uint32_t LastEdge;        /* Button: cycle stamp of the latest edge */
+
+    uint32_t WindowCycles;    /* Button: debounce window in HCLK cycles */
+
+    uint32_t WindowUs;        /* Button: debounce window in microseconds */
+
+    uint8_t Role;             /* INPUT_LineRoleTypeDef */
+
+    uint8_t Level;            /* Button: debounced level. Encoder A: last AB state */
+
+    uint8_t Partner;          /* Encoder: line of the other channel */
+
+    int8_t Accum;             /* Encoder A: steps accumulated towards a detent */
+
+    uint8_t Steps;            /* Encoder A: steps per detent */
+} INPUT_LineTypeDef;
+/* Private define ------------------------------------------------------------*/
+#if ((HAL_INPUT_QUEUE_SIZE & (HAL_INPUT_QUEUE_SIZE - 1U)) != 0U) || (HAL_INPUT_QUEUE_SIZE > 128U)
+#error "HAL_INPUT_QUEUE_SIZE must be a power of 2 up to 128"
+#endif
+
+#define INPUT_QUEUE_MASK      (HAL_INPUT_QUEUE_SIZE - 1U)
+#define INPUT_LINES           8U
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static INPUT_LineTypeDef InputLine[INPUT_LINES];
+static volatile uint8_t InputPending = 0;           /* Buttons with an open debounce window */
+static INPUT_EventTypeDef InputQueue[HAL_INPUT_QUEUE_SIZE];
+static volatile uint8_t InputHead = 0;              /* Next slot written by the interrupts */
+static volatile uint8_t InputTail = 0;              /* Next slot read by the application */
+static volatile uint32_t InputDropped = 0;
+
+/* Quadrature transitions indexed by (previous AB << 2) | current AB */
+static const int8_t InputQuadTable[16] =
+{
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+static TICK_TaskTypeDef InputTask;
+static RCC_ClockNotifierTypeDef InputNotifier;
+/* Private function prototypes -----------------------------------------------*/
+static void INPUT_EdgeCallback(uint16_t GPIO_Pin, void *Context);
+static void INPUT_DebounceTask(void *Context);
+static void INPUT_ClockChangeCallback(const RCC_ClocksTypeDef *RCC_Clocks, void *Context);
+static void INPUT_Post(uint32_t Timestamp, uint8_t Line, uint8_t Id, int8_t Value);
+static uint32_t INPUT_UsToCycles(uint32_t Us, uint32_t Hclk);
+static void INPUT_LineEnable(GPIO_TypeDef *GPIOx, uint8_t GPIO_PinSource, INPUT_LineTypeDef *line);
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Starts the input engine: registers the debounce tick task and the
+  *         clock change notifier.
+  * @note   EXTI lines 0..7 must be served by HAL_GPIO_EXTI_Dispatch(), either
+  *         with HAL_GPIO_EXTI_DISPATCH defined or from the user handler.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_INPUT_Init(void)
+{
+    HAL_StatusTypeDef status = HAL_OK;
+
+    InputTask.Callback = INPUT_DebounceTask;
+    InputTask.Context = NULL;
+    InputTask.Period = 1U;
+    InputTask.Phase = 0U;
+
+    status = HAL_TickTaskRegister(&InputTask);
+
+    if (status == HAL_BUSY)
+    {
+        /* Already running */
+        return HAL_OK;
+    }
+
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+
+    InputHead = 0U;
+    InputTail = 0U;
+    InputDropped = 0U;
+    InputPending = 0U;
+
+    InputNotifier.Callback = INPUT_ClockChangeCallback;
+    InputNotifier.Context = NULL;
+
+    return HAL_RCC_RegisterClockNotifier(&InputNotifier);
+}
+
+/**
+  * @brief  Stops the input engine and releases every line.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_INPUT_DeInit(void)
+{
+    uint8_t line = 0x00;
+
+    for (line = 0x00; line < INPUT_LINES; line++)
+    {
+        if (InputLine[line].Role != INPUT_LINE_UNUSED)
+        {
+            (void)HAL_INPUT_Release(line);
+        }
+    }
+
+    (void)HAL_TickTaskUnregister(&InputTask);
+    (void)HAL_RCC_UnregisterClockNotifier(&InputNotifier);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Routes a pin to its EXTI line and debounces it on both edges.
+  * @note   The pin mode (pull-up, pull-down, floating) is left to the caller,
+  *         through HAL_GPIO_Init() which also holds the port clock.
+  *         The window is closed by the tick task, so its resolution is one tick.
+  *         A transition is reported when the pin has been quiet for DebounceUs
+  *         and its level differs from the last reported one.
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_PinSource GPIO_PinSourcex where x can be (0..7).
+  * @param  DebounceUs debounce window in microseconds.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_INPUT_ConfigButton(GPIO_TypeDef *GPIOx, uint8_t GPIO_PinSource, uint32_t DebounceUs)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
+    HAL_PARAM_CHECK(IS_GPIO_PIN_SOURCE(GPIO_PinSource));
+
+    INPUT_LineTypeDef *line = &InputLine[GPIO_PinSource];
+
+    if (line->Role != INPUT_LINE_UNUSED)
+    {
+        return HAL_BUSY;
+    }
+
+    line->Role = INPUT_LINE_BUTTON;
+    line->WindowUs = DebounceUs;
+    line->WindowCycles = INPUT_UsToCycles(DebounceUs, SystemCoreClock);
+    line->Level = (uint8_t)HAL_GPIO_FastRead(GPIOx, (uint16_t)(1U << GPIO_PinSource));
+
+    INPUT_LineEnable(GPIOx, GPIO_PinSource, line);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Decodes a quadrature encoder on two EXTI lines.
+  * @note   Every edge is decoded immediately from a transition table, contact
+  *         bounce produces opposite steps that cancel out, so no debounce
+  *         window is needed. One event is posted per detent.
+  * @param  GPIOx_A port of channel A, where x can be (A..D).
+  * @param  GPIO_PinSource_A pin of channel A, GPIO_PinSourcex where x can be (0..7).
+  * @param  GPIOx_B port of channel B, where x can be (A..D).
+  * @param  GPIO_PinSource_B pin of channel B, must differ from channel A.
+  * @param  StepsPerDetent quadrature steps per detent (1, 2 or 4).
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_INPUT_ConfigEncoder(GPIO_TypeDef *GPIOx_A, uint8_t GPIO_PinSource_A,
+                                          GPIO_TypeDef *GPIOx_B, uint8_t GPIO_PinSource_B,
+                                          uint8_t StepsPerDetent)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx_A));
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx_B));
+    HAL_PARAM_CHECK(IS_GPIO_PIN_SOURCE(GPIO_PinSource_A));
+    HAL_PARAM_CHECK(IS_GPIO_PIN_SOURCE(GPIO_PinSource_B));
+    HAL_PARAM_CHECK(GPIO_PinSource_A != GPIO_PinSource_B);
+    HAL_PARAM_CHECK(IS_INPUT_DETENT(StepsPerDetent));
+
+    INPUT_LineTypeDef *line_a = &InputLine[GPIO_PinSource_A];
+    INPUT_LineTypeDef *line_b = &InputLine[GPIO_PinSource_B];
+
+    if ((line_a->Role != INPUT_LINE_UNUSED) || (line_b->Role != INPUT_LINE_UNUSED))
+    {
+        return HAL_BUSY;
+    }
+
+    line_a->Role = INPUT_LINE_ENCODER_A;
+    line_a->Partner = GPIO_PinSource_B;
+    line_a->Steps = StepsPerDetent;
+    line_a->Accum = 0;
+    line_a->Port = GPIOx_A;
+    line_b->Role = INPUT_LINE_ENCODER_B;
+    line_b->Partner = GPIO_PinSource_A;
+    line_b->Port = GPIOx_B;
+    line_a->Level = (uint8_t)((HAL_GPIO_FastRead(GPIOx_A, (uint16_t)(1U << GPIO_PinSource_A)) << 1) |
+                              HAL_GPIO_FastRead(GPIOx_B, (uint16_t)(1U << GPIO_PinSource_B)));
+
+    INPUT_LineEnable(GPIOx_A, GPIO_PinSource_A, line_a);
+    INPUT_LineEnable(GPIOx_B, GPIO_PinSource_B, line_b);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Stops watching a line, both lines of an encoder are released together.
+  * @note   The lines are masked through HAL_GPIO_EXTI_Disable(), which gives
+  *         back their hold on the AFIO clock.
+  * @param  GPIO_PinSource GPIO_PinSourcex where x can be (0..7).
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_INPUT_Release(uint8_t GPIO_PinSource)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_PIN_SOURCE(GPIO_PinSource));
+
+    INPUT_LineTypeDef *line = &InputLine[GPIO_PinSource];
+    uint32_t lines = 1UL << GPIO_PinSource;
+    uint32_t ms;
+
+    if (line->Role == INPUT_LINE_UNUSED)
+    {
+        return HAL_ERROR;
+    }
+
+    if ((line->Role == INPUT_LINE_ENCODER_A) || (line->Role == INPUT_LINE_ENCODER_B))
+    {
+        lines |= 1UL << line->Partner;
+        InputLine[line->Partner].Role = INPUT_LINE_UNUSED;
+        (void)HAL_GPIO_EXTI_UnregisterCallback(line->Partner);
+    }
+
+    ms = _irq_lock();
+    HAL_GPIO_EXTI_Disable((uint16_t)lines, GPIO_EXTI_MODE_IT | GPIO_EXTI_MODE_EVT);
+    CLEAR_BIT(EXTI->RTENR, lines);
+    CLEAR_BIT(EXTI->FTENR, lines);
+    WRITE_REG(EXTI->INTFR, lines);
+    InputPending &= (uint8_t)~lines;
+    _irq_unlock(ms);
+
+    line->Role = INPUT_LINE_UNUSED;
+    (void)HAL_GPIO_EXTI_UnregisterCallback(GPIO_PinSource);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Pops the oldest input event.
+  * @param  Event receives the event.
+  * @retval TRUE if an event was returned, FALSE if the queue is empty.
+  */
+uint8_t HAL_INPUT_GetEvent(INPUT_EventTypeDef *Event)
+{
+    uint8_t tail = InputTail;
+
+    if (tail == InputHead)
+    {
+        return FALSE;
+    }
+
+    *Event = InputQueue[tail & INPUT_QUEUE_MASK];
+    InputTail = (uint8_t)(tail + 1U);
+
+    return TRUE;
+}
+
+/**
+  * @brief  Number of events lost because the queue was full.
+  * @retval dropped event count
+  */
+uint32_t HAL_INPUT_GetDropped(void)
+{
+    return InputDropped;
+}
+
+/* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  EXTI callback shared by every input line.
+  * @param  GPIO_Pin pin of the line that fired.
+  * @param  Context pointer to the INPUT_LineTypeDef of the line.
+  * @retval None
+  */
+static void INPUT_EdgeCallback(uint16_t GPIO_Pin, void *Context)
+{
+    uint32_t now = HAL_GetCycles();
+    INPUT_LineTypeDef *line = (INPUT_LineTypeDef *)Context;
+    INPUT_LineTypeDef *enc;
+    uint8_t state = 0x00;
+    uint8_t line_a = 0x00;
+
+    switch (line->Role)
+    {
+        case INPUT_LINE_BUTTON:
+            /* Open the window on the first edge, push it back on every edge */
+            if ((InputPending & GPIO_Pin) == 0U)
+            {
+                line->FirstEdge = now;
+                InputPending |= (uint8_t)GPIO_Pin;
+            }
+            line->LastEdge = now;
+            break;
+
+        case INPUT_LINE_ENCODER_A:
+        case INPUT_LINE_ENCODER_B:
+            if (line->Role == INPUT_LINE_ENCODER_A)
+            {
+                enc = line;
+                line_a = (uint8_t)(line - InputLine);
+            }
+            else
+            {
+                line_a = line->Partner;
+                enc = &InputLine[line_a];
+            }
+
+            state = (uint8_t)((HAL_GPIO_FastRead(enc->Port, (uint16_t)(1U << line_a)) << 1) |
+                              HAL_GPIO_FastRead(InputLine[enc->Partner].Port, (uint16_t)(1U << enc->Partner)));
+
+            enc->Accum += InputQuadTable[(enc->Level << 2) | state];
+            enc->Level = state;
+
+            if (enc->Accum >= (int8_t)enc->Steps)
+            {
+                enc->Accum -= (int8_t)enc->Steps;
+                INPUT_Post(now, line_a, HAL_INPUT_EVT_ENCODER, 1);
+            }
+            else if (enc->Accum <= -(int8_t)enc->Steps)
+            {
+                enc->Accum += (int8_t)enc->Steps;
+                INPUT_Post(now, line_a, HAL_INPUT_EVT_ENCODER, -1);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  Tick task closing the debounce windows that have been quiet long enough.
+  * @param  Context unused.
+  * @retval None
+  */
+static void INPUT_DebounceTask(void *Context)
+{
+    UNUSED(Context);
+
+    INPUT_LineTypeDef *line;
+    uint32_t now = 0x00, ms = 0x00;
+    uint8_t pending = InputPending;
+    uint8_t index = 0x00, level = 0x00;
+
+    for (index = 0x00; pending != 0U; index++, pending >>= 1)
+    {
+        if ((pending & 0x01U) == 0U)
+        {
+            continue;
+        }
+
+        line = &InputLine[index];
+
+        /* An EXTI edge may land in between, check and close under lock */
+        ms = _irq_lock();
+        now = HAL_GetCycles();
+
+        if ((now - line->LastEdge) < line->WindowCycles)
+        {
+            _irq_unlock(ms);
+            continue;
+        }
+
+        InputPending &= (uint8_t)~(1U << index);
+        _irq_unlock(ms);
+
+        level = (uint8_t)HAL_GPIO_FastRead(line->Port, (uint16_t)(1U << index));
+
+        if (level != line->Level)
+        {
+            line->Level = level;
+            INPUT_Post(line->FirstEdge, index,
+                       (level != 0U) ? HAL_INPUT_EVT_RISING : HAL_INPUT_EVT_FALLING, (int8_t)level);
+        }
+    }
+}
+
+/**
+  * @brief  Pushes an event, drops it when the queue is full.
+  * @note   Producers are the EXTI and SysTick interrupts which may nest.
+  * @retval None
+  */
+static void INPUT_Post(uint32_t Timestamp, uint8_t Line, uint8_t Id, int8_t Value)
+{
+    INPUT_EventTypeDef *evt;
+    uint32_t ms = _irq_lock();
+    uint8_t head = InputHead;
+
+    if ((uint8_t)(head - InputTail) >= HAL_INPUT_QUEUE_SIZE)
+    {
+        InputDropped++;
+    }
+    else
+    {
+        evt = &InputQueue[head & INPUT_QUEUE_MASK];
+        evt->Timestamp = Timestamp;
+        evt->Line = Line;
+        evt->Id = Id;
+        evt->Value = Value;
+        evt->Reserved = 0U;
+        InputHead = (uint8_t)(head + 1U);
+    }
+
+    _irq_unlock(ms);
+}
+
+/**
+  * @brief  Rescales the debounce windows after a system clock change.
+  * @param  RCC_Clocks new clock frequencies.
+  * @param  Context unused.
+  * @retval None
+  */
+static void INPUT_ClockChangeCallback(const RCC_ClocksTypeDef *RCC_Clocks, void *Context)
+{
+    UNUSED(Context);
+
+    uint8_t index = 0x00;
+
+    for (index = 0x00; index < INPUT_LINES; index++)
+    {
+        if (InputLine[index].Role == INPUT_LINE_BUTTON)
+        {
+            InputLine[index].WindowCycles = INPUT_UsToCycles(InputLine[index].WindowUs, RCC_Clocks->HCLK_Frequency);
+        }
+    }
+}
+
+/**
+  * @brief  Converts microseconds to HCLK cycles (done at configuration time only).
+  * @retval cycles, saturated to 0xFFFFFFFF
+  */
+static uint32_t INPUT_UsToCycles(uint32_t Us, uint32_t Hclk)
+{
+    uint64_t cycles = ((uint64_t)Us * Hclk) / 1000000U;
+
+    return (cycles > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)cycles;
+}
+
+/**
+  * @brief  Routes a pin to its EXTI line and enables both edges.
+  * @retval None
+  */
+static void INPUT_LineEnable(GPIO_TypeDef *GPIOx, uint8_t GPIO_PinSource, INPUT_LineTypeDef *line)
+{
+    uint32_t bit = 1UL << GPIO_PinSource;
+    uint32_t ms;
+
+    line->Port = GPIOx;
+    (void)HAL_GPIO_EXTI_RegisterCallback(GPIO_PinSource, INPUT_EdgeCallback, line);
+    HAL_GPIO_EXTILineConfig(GPIO_GET_PORT_SOURCE(GPIOx), GPIO_PinSource);
+
+    ms = _irq_lock();
+    SET_BIT(EXTI->RTENR, bit);
+    SET_BIT(EXTI->FTENR, bit);
+    WRITE_REG(EXTI->INTFR, bit);
+    SET_BIT(EXTI->INTENR, bit);
+    _irq_unlock(ms);
+}
@@ -12,15 +12,38 @@
 #include <ch32v00x_hal.h>
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define NVIC_MTVEC_MODE_Mask       ((uint32_t)0x00000003)   /* mtvec MODE0 (vectored) | MODE1 (absolute address table) */
+#define NVIC_MCAUSE_CODE_Mask      ((uint32_t)0x000000FF)   /* mcause exception / interrupt number */
+#define NVIC_MCAUSE_INTERRUPT      ((uint32_t)0x80000000)   /* mcause set: interrupt, clear: synchronous exception */
+#define NVIC_PRIO_PREEMPT_Pos      7U                       /* IPRIOR preemption bit, nesting enabled */
+#define NVIC_PRIO_SUB_Pos          6U                       /* IPRIOR sub priority bit(s) */
+#define NVIC_VTFADDR_EN            ((uint32_t)0x00000001)   /* VTFADDR channel enable */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-__IO uint32_t NVIC_Priority_Group = 0;
+__IO uint32_t NVIC_Priority_Group = (INTSYSCR_INEST == INTSYSCR_INEST_EN) ? NVIC_PriorityGroup_1 : NVIC_PriorityGroup_0;
+#ifdef HAL_NVIC_USE_RAM_VECTORS
+static uint32_t NVIC_RamVectors[HAL_NVIC_VECTOR_COUNT] __attribute__((aligned(HAL_NVIC_VECTOR_ALIGN)));
+static NVIC_HandlerTypeDef NVIC_Handler[HAL_NVIC_VECTOR_COUNT];
+static void *NVIC_Context[HAL_NVIC_VECTOR_COUNT];
+static const uint32_t *NVIC_FlashVectors = NULL;
+#endif /* HAL_NVIC_USE_RAM_VECTORS */
+#ifdef HAL_USE_ISR_TRACE
+static NVIC_IsrStatsTypeDef NVIC_IsrStats[HAL_ISR_TRACE_SLOTS];
+static uint8_t NVIC_IsrSlot[HAL_NVIC_VECTOR_COUNT];   /* slot + 1, 0 if not traced yet */
+static uint8_t NVIC_IsrSlotsUsed = 0;
+#endif /* HAL_USE_ISR_TRACE */
 /* Private function prototypes -----------------------------------------------*/
+#ifdef HAL_NVIC_USE_RAM_VECTORS
+static void NVIC_Dispatch(void);
+#endif /* HAL_NVIC_USE_RAM_VECTORS */
 /* Exported functions ---------------------------------------------------------*/
 /*********************************************************************
  * @fn      HAL_NVIC_PriorityGroupConfig
  *
  * @brief   Configures the priority grouping - pre-emption priority and subpriority.
+ *          The grouping follows interrupt nesting, CSR-0x804 bit1 is updated.
+ *          Call it before enabling interrupts, the priority bits of the
+ *          interrupts already configured are not re-encoded.
  *
  * @param   NVIC_PriorityGroup - specifies the priority grouping bits length.
  *            NVIC_PriorityGroup_0 - 0 bits for pre-emption priority
@@ -33,9 +56,60 @@ __IO uint32_t NVIC_Priority_Group = 0;
 void HAL_NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup)
 {
     HAL_PARAM_CHECK(IS_NVIC_PRI_GROUP(NVIC_PriorityGroup));
+
+    if (NVIC_PriorityGroup == NVIC_PriorityGroup_1)
+    {
+        __asm volatile ("csrs 0x804, %0" :: "r"(NVIC_INTSYSCR_INESTEN) : "memory");
+    }
+    else
+    {
+        __asm volatile ("csrc 0x804, %0" :: "r"(NVIC_INTSYSCR_INESTEN) : "memory");
+    }
+
     NVIC_Priority_Group = NVIC_PriorityGroup;
 }
 
+/**
+  * @brief  Priority grouping in use, read back from CSR-0x804.
+  * @retval NVIC_PriorityGroup_1 if interrupt nesting is enabled,
+  *         NVIC_PriorityGroup_0 otherwise.
+  */
+uint32_t HAL_NVIC_GetPriorityGroup(void)
+{
+    uint32_t intsyscr = 0x00;
+
+    __asm volatile ("csrr %0, 0x804" : "=r"(intsyscr));
+
+    return ((intsyscr & NVIC_INTSYSCR_INESTEN) != 0U) ? NVIC_PriorityGroup_1 : NVIC_PriorityGroup_0;
+}
+
+/**
+  * @brief  Enables or disables the hardware prologue/epilogue (HPE).
+  * @note   The HAL ISRs are declared with HAL_IRQ_FAST and rely on HPE to
+  *         save their registers: disabling it is refused unless
+  *         HAL_NVIC_NO_HPE is defined.
+  * @param  NewState ENABLE or DISABLE.
+  * @retval HAL_ERROR if HPE can not be disabled, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_NVIC_ConfigHPE(FunctionalState NewState)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_NVIC_CHANNEL_CMD(NewState));
+
+    if (NewState != DISABLE)
+    {
+        __asm volatile ("csrs 0x804, %0" :: "r"(NVIC_INTSYSCR_HWSTKEN) : "memory");
+        return HAL_OK;
+    }
+
+#ifndef HAL_NVIC_NO_HPE
+    return HAL_ERROR;
+#else
+    __asm volatile ("csrc 0x804, %0" :: "r"(NVIC_INTSYSCR_HWSTKEN) : "memory");
+    return HAL_OK;
+#endif
+}
+
 /*********************************************************************
  * @fn      HAL_NVIC_Init
  *
@@ -57,39 +131,104 @@ void HAL_NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup)
 void HAL_NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct)
 {
     HAL_PARAM_CHECK(IS_NVIC_IRQ_CHANNEL(NVIC_InitStruct->NVIC_IRQChannel));
-    HAL_PARAM_CHECK(IS_NVIC_PREEMPTION_PRIORITY(NVIC_InitStruct->NVIC_IRQChannelPreemptionPriority));
-    HAL_PARAM_CHECK(IS_NVIC_SUB_PRIORITY(NVIC_InitStruct->NVIC_IRQChannelSubPriority));
     HAL_PARAM_CHECK(IS_NVIC_CHANNEL_CMD(NVIC_InitStruct->NVIC_IRQChannelCmd));
 
-#if (INTSYSCR_INEST == INTSYSCR_INEST_NoEN)
-    if (NVIC_Priority_Group == NVIC_PriorityGroup_0)
+    HAL_NVIC_SetPriority((IRQn_Type)NVIC_InitStruct->NVIC_IRQChannel,
+                         NVIC_InitStruct->NVIC_IRQChannelPreemptionPriority,
+                         NVIC_InitStruct->NVIC_IRQChannelSubPriority);
+
+    if (NVIC_InitStruct->NVIC_IRQChannelCmd != DISABLE)
     {
-        NVIC_SetPriority(NVIC_InitStruct->NVIC_IRQChannel, NVIC_InitStruct->NVIC_IRQChannelSubPriority << 6);
+        NVIC_EnableIRQ(NVIC_InitStruct->NVIC_IRQChannel);
     }
-#else
-    if (NVIC_Priority_Group == NVIC_PriorityGroup_1)
+    else
     {
-        if (NVIC_InitStruct->NVIC_IRQChannelPreemptionPriority == 1)
-        {
-            NVIC_SetPriority(NVIC_InitStruct->NVIC_IRQChannel, (1 << 7) | (NVIC_InitStruct->NVIC_IRQChannelSubPriority << 6));
-        }
-        else if (NVIC_InitStruct->NVIC_IRQChannelPreemptionPriority == 0)
-        {
-            NVIC_SetPriority(NVIC_InitStruct->NVIC_IRQChannel, (0 << 7) | (NVIC_InitStruct->NVIC_IRQChannelSubPriority << 6));
-        }
+        NVIC_DisableIRQ(NVIC_InitStruct->NVIC_IRQChannel);
     }
-#endif
+}
 
-    if (NVIC_InitStruct->NVIC_IRQChannelCmd != DISABLE)
+/**
+  * @brief  Sets the priority of an interrupt.
+  * @note   The encoding follows the priority grouping in use (CSR-0x804 bit1):
+  *         with nesting, bit7 is the preemption priority and bit6 the sub
+  *         priority, without nesting bits[7:6] are the sub priority.
+  *         A lower value is a higher priority.
+  * @param  IRQn External interrupt number.
+  * @param  PreemptPriority 0 or 1 with nesting, 0 without.
+  * @param  SubPriority 0 or 1 with nesting, 0 to 3 without.
+  * @retval None
+  */
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    uint32_t group = HAL_NVIC_GetPriorityGroup();
+
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_NVIC_IRQ_CHANNEL(IRQn));
+    HAL_PARAM_CHECK(IS_NVIC_PREEMPTION_PRIORITY(group, PreemptPriority));
+    HAL_PARAM_CHECK(IS_NVIC_SUB_PRIORITY(group, SubPriority));
+
+    NVIC_SetPriority(IRQn, (uint8_t)((PreemptPriority << NVIC_PRIO_PREEMPT_Pos) | (SubPriority << NVIC_PRIO_SUB_Pos)));
+}
+
+/**
+  * @brief  Gets the priority of an interrupt, decoded for the priority grouping in use.
+  * @param  IRQn External interrupt number.
+  * @param  pPreemptPriority pointer to the preemption priority.
+  * @param  pSubPriority pointer to the sub priority.
+  * @retval None
+  */
+void HAL_NVIC_GetPriority(IRQn_Type IRQn, uint32_t *pPreemptPriority, uint32_t *pSubPriority)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_NVIC_IRQ_CHANNEL(IRQn));
+    HAL_PARAM_CHECK(pPreemptPriority != NULL);
+    HAL_PARAM_CHECK(pSubPriority != NULL);
+
+    uint32_t prio = READ_REG(NVIC->IPRIOR[IRQn]);
+
+    if (HAL_NVIC_GetPriorityGroup() == NVIC_PriorityGroup_1)
     {
-        NVIC_EnableIRQ(NVIC_InitStruct->NVIC_IRQChannel);
+        *pPreemptPriority = (prio >> NVIC_PRIO_PREEMPT_Pos) & 0x01U;
+        *pSubPriority = (prio >> NVIC_PRIO_SUB_Pos) & 0x01U;
     }
     else
     {
-        NVIC_DisableIRQ(NVIC_InitStruct->NVIC_IRQChannel);
+        *pPreemptPriority = 0U;
+        *pSubPriority = (prio >> NVIC_PRIO_SUB_Pos) & 0x03U;
     }
 }
 
+/**
+  * @brief  Attaches an interrupt to a vector table free (VTF) channel.
+  * @note   The PFIC jumps straight to Isr without fetching the vector table,
+  *         the shortest entry path for a critical interrupt such as UART RX.
+  *         Isr must be declared with HAL_IRQ_FAST.
+  * @param  Channel VTF channel, 0 to NVIC_VTF_CHANNELS - 1.
+  * @param  IRQn External interrupt number.
+  * @param  Isr interrupt service routine, NULL releases the channel.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_NVIC_ConfigFastIRQ(uint32_t Channel, IRQn_Type IRQn, void (*Isr)(void))
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_NVIC_VTF_CHANNEL(Channel));
+    HAL_PARAM_CHECK(IS_NVIC_IRQ_CHANNEL(IRQn));
+
+    uint32_t ms = _irq_lock();
+
+    WRITE_REG(NVIC->VTFADDR[Channel], 0U);
+
+    if (Isr != NULL)
+    {
+        NVIC->VTFIDR[Channel] = (uint8_t)IRQn;
+        WRITE_REG(NVIC->VTFADDR[Channel], ((uint32_t)Isr & ~NVIC_VTFADDR_EN) | NVIC_VTFADDR_EN);
+    }
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
 /**
   * @brief  Enables a device specific interrupt in the NVIC interrupt controller.
   * @note   To configure interrupts priority correctly, the HAL_NVIC_PriorityGroupConfig()
@@ -130,4 +269,283 @@ void HAL_NVIC_SystemReset(void)
 {
     /* System Reset */
     NVIC_SystemReset();
-}
\ No newline at end of file
+}
+
+#ifdef HAL_NVIC_USE_RAM_VECTORS
+/**
+  * @brief  Moves the vector table to RAM so handlers can be installed at run time.
+  * @note   The table in use is copied, then mtvec is pointed at the copy in
+  *         vectored, absolute address mode: the PFIC fetches the handler
+  *         address of each interrupt directly from RAM.
+  *         Calling it again keeps the RAM table and its registrations.
+  * @retval HAL_ERROR if the startup code did not set mtvec to the absolute
+  *         address vectored mode (the table then holds jump instructions),
+  *         HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_NVIC_InitVectors(void)
+{
+    uint32_t mtvec = 0x00;
+    uint32_t ms = 0x00;
+    uint32_t i = 0x00;
+
+    if (NVIC_FlashVectors != NULL)
+    {
+        return HAL_OK;
+    }
+
+    __asm volatile ("csrr %0, mtvec" : "=r"(mtvec));
+
+    if ((mtvec & NVIC_MTVEC_MODE_Mask) != NVIC_MTVEC_MODE_Mask)
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+
+    NVIC_FlashVectors = (const uint32_t *)(mtvec & ~NVIC_MTVEC_MODE_Mask);
+
+    for (i = 0; i < HAL_NVIC_VECTOR_COUNT; i++)
+    {
+        NVIC_RamVectors[i] = NVIC_FlashVectors[i];
+    }
+
+    mtvec = (uint32_t)NVIC_RamVectors | NVIC_MTVEC_MODE_Mask;
+    __asm volatile ("csrw mtvec, %0" :: "r"(mtvec) : "memory");
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Routes an interrupt to a handler with its own context.
+  * @note   The vector is pointed at a common dispatcher which calls
+  *         Handler(Context) with a single indirect call, so several instances
+  *         of a driver can each own an interrupt.
+  *         The interrupt enable and priority are left unchanged.
+  * @param  IRQn interrupt number, NonMaskableInt_IRQn and above.
+  * @param  Handler plain C function, NULL restores the startup vector.
+  * @param  Context passed to Handler on every interrupt.
+  * @retval HAL_ERROR if HAL_NVIC_InitVectors() has not succeeded, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_NVIC_RegisterHandler(IRQn_Type IRQn, NVIC_HandlerTypeDef Handler, void *Context)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_NVIC_VECTOR(IRQn));
+
+    uint32_t ms = 0x00;
+
+    if (NVIC_FlashVectors == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+
+    NVIC_Handler[IRQn] = Handler;
+    NVIC_Context[IRQn] = Context;
+    NVIC_RamVectors[IRQn] = (Handler != NULL) ? (uint32_t)NVIC_Dispatch : NVIC_FlashVectors[IRQn];
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Installs an interrupt service routine directly in the vector table.
+  * @note   No dispatcher is involved: the PFIC jumps straight to Isr, which
+  *         must be declared with __attribute__((interrupt)). Any handler
+  *         registered for this interrupt is dropped.
+  * @param  IRQn interrupt number, NonMaskableInt_IRQn and above.
+  * @param  Isr interrupt service routine, NULL restores the startup vector.
+  * @retval HAL_ERROR if HAL_NVIC_InitVectors() has not succeeded, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_NVIC_SetVector(IRQn_Type IRQn, void (*Isr)(void))
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_NVIC_VECTOR(IRQn));
+
+    uint32_t ms = 0x00;
+
+    if (NVIC_FlashVectors == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+
+    NVIC_Handler[IRQn] = NULL;
+    NVIC_Context[IRQn] = NULL;
+    NVIC_RamVectors[IRQn] = (Isr != NULL) ? (uint32_t)Isr : NVIC_FlashVectors[IRQn];
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+#endif /* HAL_NVIC_USE_RAM_VECTORS */
+
+#ifdef HAL_USE_ISR_TRACE
+/**
+  * @brief  Accounts one ISR run, called by HAL_ISR_EXIT().
+  * @note   The duration runs from HAL_ISR_ENTER() to this call and includes
+  *         the time spent in nested interrupts. It is measured with
+  *         HAL_GetCycles() and reads 0 while SysTick is stopped.
+  *         Interrupts past the HAL_ISR_TRACE_SLOTS first ones are not traced.
+  * @param  IRQn interrupt number.
+  * @param  Start HAL_GetCycles() value taken by HAL_ISR_ENTER().
+  * @retval None
+  */
+void HAL_NVIC_IsrTraceRecord(IRQn_Type IRQn, uint32_t Start)
+{
+    uint32_t cycles = HAL_GetCycles() - Start;
+    uint32_t slot = 0x00;
+    uint32_t ms = 0x00;
+    NVIC_IsrStatsTypeDef *stats;
+
+    if ((uint32_t)IRQn >= HAL_NVIC_VECTOR_COUNT)
+    {
+        return;
+    }
+
+    slot = NVIC_IsrSlot[IRQn];
+
+    if (slot == 0U)
+    {
+        ms = _irq_lock();
+
+        if (NVIC_IsrSlotsUsed >= HAL_ISR_TRACE_SLOTS)
+        {
+            _irq_unlock(ms);
+            return;
+        }
+
+        slot = ++NVIC_IsrSlotsUsed;
+        NVIC_IsrStats[slot - 1U].MinCycles = 0xFFFFFFFFU;
+        NVIC_IsrSlot[IRQn] = (uint8_t)slot;
+
+        _irq_unlock(ms);
+    }
+
+    stats = &NVIC_IsrStats[slot - 1U];
+
+    stats->Count++;
+    stats->TotalCycles += cycles;
+
+    if (cycles < stats->MinCycles)
+    {
+        stats->MinCycles = cycles;
+    }
+
+    if (cycles > stats->MaxCycles)
+    {
+        stats->MaxCycles = cycles;
+    }
+}
+
+/**
+  * @brief  Snapshot of the duration statistics of one interrupt.
+  * @param  IRQn interrupt number.
+  * @param  pStats pointer to the statistics, AvgCycles is computed here.
+  * @retval HAL_ERROR if the interrupt has not been traced, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_NVIC_GetIsrStats(IRQn_Type IRQn, NVIC_IsrStatsTypeDef *pStats)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_NVIC_VECTOR(IRQn));
+    HAL_PARAM_CHECK(pStats != NULL);
+
+    uint32_t ms = 0x00;
+    uint32_t slot = NVIC_IsrSlot[IRQn];
+
+    if (slot == 0U)
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+    *pStats = NVIC_IsrStats[slot - 1U];
+    _irq_unlock(ms);
+
+    /* 64-bit division, kept out of the interrupt path */
+    pStats->AvgCycles = (pStats->Count != 0U) ? (uint32_t)(pStats->TotalCycles / pStats->Count) : 0U;
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Clears the statistics and releases every trace slot.
+  * @retval None
+  */
+void HAL_NVIC_ResetIsrStats(void)
+{
+    uint32_t ms = _irq_lock();
+    uint32_t i = 0x00;
+
+    for (i = 0; i < HAL_NVIC_VECTOR_COUNT; i++)
+    {
+        NVIC_IsrSlot[i] = 0U;
+    }
+
+    for (i = 0; i < HAL_ISR_TRACE_SLOTS; i++)
+    {
+        NVIC_IsrStats[i].Count = 0U;
+        NVIC_IsrStats[i].MinCycles = 0U;
+        NVIC_IsrStats[i].MaxCycles = 0U;
+        NVIC_IsrStats[i].AvgCycles = 0U;
+        NVIC_IsrStats[i].TotalCycles = 0U;
+    }
+
+    NVIC_IsrSlotsUsed = 0U;
+
+    _irq_unlock(ms);
+}
+
+/**
+  * @brief  Reports the statistics of every traced interrupt.
+  * @note   Each snapshot is taken with interrupts masked, Callback runs with
+  *         interrupts in their previous state and may print or log.
+  * @param  Callback called once per traced interrupt, in IRQ number order.
+  * @param  Context passed to Callback.
+  * @retval None
+  */
+void HAL_NVIC_DumpIsrStats(NVIC_IsrDumpTypeDef Callback, void *Context)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(Callback != NULL);
+
+    NVIC_IsrStatsTypeDef stats;
+    uint32_t irq = 0x00;
+
+    for (irq = (uint32_t)NonMaskableInt_IRQn; irq < HAL_NVIC_VECTOR_COUNT; irq++)
+    {
+        if (HAL_NVIC_GetIsrStats((IRQn_Type)irq, &stats) == HAL_OK)
+        {
+            Callback((IRQn_Type)irq, &stats, Context);
+        }
+    }
+}
+#endif /* HAL_USE_ISR_TRACE */
+
+/* Privated functions ---------------------------------------------------------*/
+#ifdef HAL_NVIC_USE_RAM_VECTORS
+/**
+  * @brief  Common entry of every registered interrupt.
+  * @note   The vector slot is only pointed here once a handler is stored, so
+  *         the lookup needs no NULL check. Synchronous exceptions all enter
+  *         through the EXC_IRQn slot with their own cause code in mcause,
+  *         which is not a vector number: they are dispatched to EXC_IRQn.
+  * @retval None
+  */
+HAL_IRQ_FAST
+static void NVIC_Dispatch(void)
+{
+    uint32_t mcause = 0x00;
+
+    __asm volatile ("csrr %0, mcause" : "=r"(mcause));
+    mcause = ((mcause & NVIC_MCAUSE_INTERRUPT) != 0U) ? (mcause & NVIC_MCAUSE_CODE_Mask) : (uint32_t)EXC_IRQn;
+
+    HAL_ISR_ENTER((IRQn_Type)mcause);
+    NVIC_Handler[mcause](NVIC_Context[mcause]);
+    HAL_ISR_EXIT((IRQn_Type)mcause);
+}
+#endif /* HAL_NVIC_USE_RAM_VECTORS */
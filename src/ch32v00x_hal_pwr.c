@@ -0,0 +1,191 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : ch32v00x_hal_pwr.c
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : PWR HAL module driver.
+ *                      This file provides hardware abstract interface to manage
+ *                      sleep / standby entry and pin-change wake-up
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+/* Includes ------------------------------------------------------------------*/
+#include <ch32v00x_hal.h>
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define PWR_SCTLR_SLEEPDEEP        ((uint32_t)0x00000004)   /* PFIC SCTLR deep sleep bit */
+#define PWR_OBR_USER_Pos           2U                       /* User option byte position in FLASH->OBR */
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint32_t PwrWakeupUs = 0;
+/* Private function prototypes -----------------------------------------------*/
+static HAL_StatusTypeDef PWR_RestoreOscillators(uint32_t Ctlr, uint32_t Cfgr0);
+/* Exported functions --------------------------------------------------------*/
+/**
+  * @brief  Configures pins as wake-up sources.
+  * @note   With PWR_ENTRY_WFE the lines only raise an event, the core resumes
+  *         right after the sleep call without taking an interrupt.
+  *         With PWR_ENTRY_WFI the lines raise their EXTI interrupt.
+  * @param  GPIOx where x can be (A..D).
+  * @param  Pins any combination of GPIO_Pin_x where x can be (0..7).
+  * @param  Trigger a value of @ref GPIO_EXTITriggerTypeDef.
+  * @param  Entry PWR_ENTRY_WFI or PWR_ENTRY_WFE, the entry that will be used.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PWR_EnableWakeupPins(GPIO_TypeDef *GPIOx, uint16_t Pins, uint8_t Trigger, uint8_t Entry)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
+    HAL_PARAM_CHECK(IS_PWR_ENTRY(Entry));
+
+    GPIO_EXTIConfigTypeDef config;
+
+    config.Lines = Pins;
+    config.PortSource = GPIO_GET_PORT_SOURCE(GPIOx);
+    config.Trigger = Trigger;
+    config.Mode = (Entry == PWR_ENTRY_WFI) ? GPIO_EXTI_MODE_IT : GPIO_EXTI_MODE_EVT;
+
+    return HAL_GPIO_EXTI_Config(&config);
+}
+
+/**
+  * @brief  Removes pins from the wake-up sources.
+  * @param  Pins any combination of GPIO_Pin_x where x can be (0..7).
+  * @retval None
+  */
+void HAL_PWR_DisableWakeupPins(uint16_t Pins)
+{
+    HAL_GPIO_EXTI_Disable(Pins, GPIO_EXTI_MODE_IT | GPIO_EXTI_MODE_EVT);
+}
+
+/**
+  * @brief  Enters Sleep mode, the core clock stops and peripherals keep running.
+  * @param  Entry PWR_ENTRY_WFI or PWR_ENTRY_WFE.
+  * @retval None
+  */
+void HAL_PWR_EnterSLEEPMode(uint8_t Entry)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_PWR_ENTRY(Entry));
+
+    CLEAR_BIT(NVIC->SCTLR, PWR_SCTLR_SLEEPDEEP);
+
+    if (Entry == PWR_ENTRY_WFI)
+    {
+        __WFI();
+    }
+    else
+    {
+        __WFE();
+    }
+}
+
+/**
+  * @brief  Enters Standby mode and restores the clock tree on wake-up.
+  * @note   RAM and registers are retained. The part wakes up on HSI with HSE
+  *         and PLL stopped: the saved oscillators are restarted with
+  *         HAL_RCC_OscConfig() and the clock source and prescaler switched
+  *         back with HAL_RCC_ClockConfig(), which sets the flash wait states
+  *         and re-times SysTick and every registered notifier (UART baud
+  *         rate, ...). The tick does not advance while in Standby.
+  *         With PWR_ENTRY_WFI the wake-up interrupt runs first, still on HSI.
+  * @param  Entry PWR_ENTRY_WFI or PWR_ENTRY_WFE.
+  * @retval HAL_ERROR if the option bytes request a reset on Standby entry
+  *         (OB_STDBY_RST), HAL_TIMEOUT if the saved clock could not be
+  *         restored (the system then runs on HSI), HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_PWR_EnterSTANDBYMode(uint8_t Entry)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_PWR_ENTRY(Entry));
+
+    RCC_ClkInitTypeDef clk = {0};
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t ctlr = 0x00, cfgr0 = 0x00;
+    uint32_t start = 0x00, cycles = 0x00, hclk = 0x00;
+
+    /* Entering would reset the part instead of retaining its state */
+    if (((READ_REG(FLASH->OBR) >> PWR_OBR_USER_Pos) & OB_STDBY_NoRST) == 0U)
+    {
+        return HAL_ERROR;
+    }
+
+    ctlr = READ_REG(RCC->CTLR);
+    cfgr0 = READ_REG(RCC->CFGR0);
+
+    (void)HAL_RCC_ClockAcquire(0U, RCC_APB1Periph_PWR);
+    SET_BIT(PWR->CTLR, PWR_CTLR_PDDS);
+    SET_BIT(NVIC->SCTLR, PWR_SCTLR_SLEEPDEEP);
+
+    if (Entry == PWR_ENTRY_WFI)
+    {
+        __WFI();
+    }
+    else
+    {
+        __WFE();
+    }
+
+    /* Running on HSI from here, SysTick still timed for the saved clock */
+    HAL_RCC_ClockChanged();
+    start = HAL_GetCycles();
+
+    CLEAR_BIT(NVIC->SCTLR, PWR_SCTLR_SLEEPDEEP);
+    CLEAR_BIT(PWR->CTLR, PWR_CTLR_PDDS);
+    (void)HAL_RCC_ClockRelease(0U, RCC_APB1Periph_PWR);
+
+    status = PWR_RestoreOscillators(ctlr, cfgr0);
+
+    hclk = HAL_RCC_GetHCLKFreq();
+    cycles = HAL_GetCycles() - start;
+    PwrWakeupUs = cycles / ((hclk >= 1000000U) ? (hclk / 1000000U) : 1U);
+
+    if (status == HAL_OK)
+    {
+        clk.SYSCLKSource = cfgr0 & RCC_SW;
+        clk.AHBCLKDivider = cfgr0 & RCC_HPRE;
+        status = HAL_RCC_ClockConfig(&clk);
+    }
+
+    return status;
+}
+
+/**
+  * @brief  Time spent restarting the oscillators on the last Standby wake-up.
+  * @retval duration in microseconds, clock switch and notifiers excluded.
+  */
+uint32_t HAL_PWR_GetWakeupTimeUs(void)
+{
+    return PwrWakeupUs;
+}
+
+/* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Restarts the HSE and PLL that were running before Standby.
+  * @note   The oscillator starts, their ordering and timeouts are those of
+  *         HAL_RCC_OscConfig().
+  * @param  Ctlr RCC->CTLR saved before entering Standby.
+  * @param  Cfgr0 RCC->CFGR0 saved before entering Standby.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef PWR_RestoreOscillators(uint32_t Ctlr, uint32_t Cfgr0)
+{
+    RCC_OscInitTypeDef osc = {0};
+
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLLState = RCC_PLL_NONE;
+
+    if ((Ctlr & RCC_HSEON) != 0U)
+    {
+        osc.OscillatorType |= RCC_OSCILLATORTYPE_HSE;
+        osc.HSEState = ((Ctlr & RCC_HSEBYP) != 0U) ? RCC_HSE_Bypass : RCC_HSE_ON;
+    }
+
+    if ((Ctlr & RCC_PLLON) != 0U)
+    {
+        osc.PLLState = RCC_PLL_ON;
+        osc.PLLSource = Cfgr0 & RCC_PLLSRC;
+    }
+
+    return HAL_RCC_OscConfig(&osc);
+}
@@ -29,6 +29,13 @@
 #define CTLR_HSEON_Reset           ((uint32_t)0xFFFEFFFF)
 #define CTLR_HSEON_Set             ((uint32_t)0x00010000)
 #define CTLR_HSITRIM_Mask          ((uint32_t)0xFFFFFF07)
+#define CTLR_HSITRIM_Pos           3U
+#define CTLR_HSITRIM_Max           ((uint8_t)0x1F)
+#define CTLR_HSION_Set             ((uint32_t)0x00000001)
+#define CTLR_HSIRDY_Set            ((uint32_t)0x00000002)
+#define CTLR_HSERDY_Set            ((uint32_t)0x00020000)
+#define CTLR_PLLON_Set             ((uint32_t)0x01000000)
+#define CTLR_PLLRDY_Set            ((uint32_t)0x02000000)
 
 #define CFGR0_PLL_Mask             ((uint32_t)0xFFFEFFFF)
 #define CFGR0_PLLMull_Mask         ((uint32_t)0x003C0000)
@@ -36,6 +43,7 @@
 #define CFGR0_PLLXTPRE_Mask        ((uint32_t)0x00020000)
 #define CFGR0_SWS_Mask             ((uint32_t)0x0000000C)
 #define CFGR0_SW_Mask              ((uint32_t)0xFFFFFFFC)
+#define CFGR0_SW_Set_Mask          ((uint32_t)0x00000003)
 #define CFGR0_HPRE_Reset_Mask      ((uint32_t)0xFFFFFF0F)
 #define CFGR0_HPRE_Set_Mask        ((uint32_t)0x000000F0)
 #define CFGR0_PPRE1_Reset_Mask     ((uint32_t)0xFFFFF8FF)
@@ -45,9 +53,28 @@
 #define CFGR0_ADCPRE_Reset_Mask    ((uint32_t)0xFFFF07FF)
 #define CFGR0_ADCPRE_Set_Mask      ((uint32_t)0x0000F800)
 
+/* FLASH ACTLR register bit mask */
+#define ACTLR_LATENCY_Mask         ((uint32_t)0x00000003)
+
+/* Reference counted clocks, RCC_RefClock[] entries below RCC_REF_APB2_COUNT are on APB2 */
+#define RCC_REF_CLOCK_COUNT        12U
+#define RCC_REF_APB2_COUNT         8U
+
+/* INTR register bit mask */
+#define INTR_CSSF_Set              ((uint32_t)0x00000080)
+#define INTR_CSSC_Set              ((uint32_t)0x00800000)
+
+/* Software interrupt finishing a CSS failure, lowest priority in both nesting modes */
+#define RCC_CSS_SWI_PRIORITY       ((uint8_t)0xC0)
+
 /* RSTSCKR register bit mask */
 #define RSTSCKR_RMVF_Set           ((uint32_t)0x01000000)
 
+/* SysTick control bits, checked by the waits and set by the boot profiler */
+#define RCC_SYSTICK_STE            ((uint32_t)0x00000001)
+#define RCC_SYSTICK_STCLK          ((uint32_t)0x00000004)
+#define RCC_SYSTICK_STRE           ((uint32_t)0x00000008)
+
 /* RCC Flag Mask */
 #define FLAG_Mask                  ((uint8_t)0x1F)
 
@@ -66,11 +93,467 @@
 /* Private variables ---------------------------------------------------------*/
 static __I uint8_t APBAHBPrescTable[16] = {1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8};
 static __I uint8_t ADCPrescTable[20] = {2, 4, 6, 8, 4, 8, 12, 16, 8, 16, 24, 32, 16, 32, 48, 64, 32, 64, 96, 128};
+static const RCC_ClkInitTypeDef RCC_ProfileTable[RCC_PROFILE_COUNT] =
+{
+    { RCC_SYSCLKSource_PLLCLK, RCC_SYSCLK_Div1 },   /* RCC_PROFILE_PLL_48MHZ */
+    { RCC_SYSCLKSource_HSI,    RCC_SYSCLK_Div1 },   /* RCC_PROFILE_HSI_24MHZ */
+    { RCC_SYSCLKSource_HSI,    RCC_SYSCLK_Div3 },   /* RCC_PROFILE_HSI_8MHZ */
+    { RCC_SYSCLKSource_HSI,    RCC_SYSCLK_Div16 },  /* RCC_PROFILE_HSI_1500KHZ */
+};
+static RCC_ClockNotifierTypeDef *RCC_NotifierList = NULL;
+static const uint32_t RCC_RefClock[RCC_REF_CLOCK_COUNT] =
+{
+    RCC_APB2Periph_AFIO, RCC_APB2Periph_GPIOA, RCC_APB2Periph_GPIOC, RCC_APB2Periph_GPIOD,
+    RCC_APB2Periph_ADC1, RCC_APB2Periph_TIM1, RCC_APB2Periph_SPI1, RCC_APB2Periph_USART1,
+    RCC_APB1Periph_TIM2, RCC_APB1Periph_WWDG, RCC_APB1Periph_I2C1, RCC_APB1Periph_PWR
+};
+static uint8_t RCC_RefCount[RCC_REF_CLOCK_COUNT];
+static uint8_t RCC_RefSeeded = FALSE;
+static uint8_t RCC_MCOActive = FALSE;
+static uint32_t RCC_CSSFallback = RCC_PROFILE_HSI_24MHZ;
+static volatile uint32_t RCC_CSSFailures = 0;
+static volatile uint8_t RCC_CSSPending = FALSE;
+static volatile uint8_t RCC_ConfigDepth = 0;   /* OscConfig/ClockConfig/SetProfile calls in progress */
+static uint32_t RCC_ResetFlags = 0;
+static uint8_t RCC_ResetFlagsRead = FALSE;
+#ifdef HAL_USE_BOOT_PROFILE
+static RCC_BootReportTypeDef RCC_BootReport;
+static uint32_t RCC_BootStart = 0;
+static uint32_t RCC_BootPhaseStart[RCC_BOOT_PHASE_COUNT];
+static uint8_t RCC_BootPhaseDepth[RCC_BOOT_PHASE_COUNT];
+static uint8_t RCC_BootProfiling = FALSE;
+#endif /* HAL_USE_BOOT_PROFILE */
+RCC_ClocksTypeDef RCC_ClockTree;
 /* Private function prototypes -----------------------------------------------*/
+static HAL_StatusTypeDef RCC_WaitFlag(__IO uint32_t *Reg, uint32_t Flag, uint32_t State);
+static uint32_t RCC_SysclkFreq(uint32_t Source, uint32_t Cfgr0);
+static uint32_t RCC_HclkFreq(uint32_t Sysclk, uint32_t Cfgr0);
+static uint32_t RCC_MeasureRef(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint16_t Periods, uint32_t Timeout);
+static int32_t RCC_ErrorPpm(uint32_t Measured, uint32_t Expected);
+static uint32_t RCC_AbsDiff(uint32_t A, uint32_t B);
+static void RCC_RefSeed(void);
+static void RCC_ConfigEnter(void);
+static void RCC_ConfigExit(void);
 /* Exported functions ---------------------------------------------------------*/
 /**
-  * @brief  The result of this function could be not correct when using
+  * @brief  Starts or stops the HSE, HSI and PLL oscillators.
+  * @note   An oscillator feeding the system clock, directly or through the
+  *         PLL, is never stopped and the running PLL is never reconfigured:
+  *         switch SYSCLK away with HAL_RCC_ClockConfig() first.
+  *         Each start waits for the ready flag for at most
+  *         HAL_RCC_STARTUP_TIMEOUT_US once SysTick runs, HAL_RCC_STARTUP_TIMEOUT
+  *         polls before HAL_TickInit().
+  * @param  RCC_OscInit pointer to a RCC_OscInitTypeDef structure.
+  * @retval HAL_ERROR on an oscillator still in use or a PLL source not
+  *         running, HAL_TIMEOUT if a ready flag did not follow, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_RCC_OscConfig(const RCC_OscInitTypeDef *RCC_OscInit)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(RCC_OscInit != NULL);
+    HAL_PARAM_CHECK(IS_RCC_OSCILLATORTYPE(RCC_OscInit->OscillatorType));
+    HAL_PARAM_CHECK(IS_RCC_PLL(RCC_OscInit->PLLState));
+    HAL_PARAM_CHECK(((RCC_OscInit->OscillatorType & RCC_OSCILLATORTYPE_HSE) == 0U) ||
+                    IS_RCC_HSE(RCC_OscInit->HSEState));
+    HAL_PARAM_CHECK(((RCC_OscInit->OscillatorType & RCC_OSCILLATORTYPE_HSI) == 0U) ||
+                    (IS_RCC_HSI(RCC_OscInit->HSIState) &&
+                     IS_RCC_CALIBRATION_VALUE(RCC_OscInit->HSICalibrationValue)));
+    HAL_PARAM_CHECK((RCC_OscInit->PLLState != RCC_PLL_ON) || IS_RCC_PLLSOURCE(RCC_OscInit->PLLSource));
+
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t cfgr = READ_REG(RCC->CFGR0);
+    uint32_t sws = (cfgr & CFGR0_SWS_Mask) >> 2;
+    uint32_t pll_hse = ((cfgr & CFGR0_PLLSRC_Mask) != 0U) ? TRUE : FALSE;
+    uint32_t hse_used = (sws == RCC_SYSCLKSource_HSE) || ((sws == RCC_SYSCLKSource_PLLCLK) && (pll_hse == TRUE));
+    uint32_t hsi_used = (sws == RCC_SYSCLKSource_HSI) || ((sws == RCC_SYSCLKSource_PLLCLK) && (pll_hse == FALSE));
+
+    RCC_ConfigEnter();
+    HAL_BOOT_PHASE_BEGIN(RCC_BOOT_PHASE_CLOCK);
+
+    /* ---- HSE ---- */
+    if ((RCC_OscInit->OscillatorType & RCC_OSCILLATORTYPE_HSE) != 0U)
+    {
+        if (hse_used)
+        {
+            /* Keeps running, only a request to stop it is an error */
+            if (RCC_OscInit->HSEState == RCC_HSE_OFF)
+            {
+                status = HAL_ERROR;
+            }
+        }
+        else
+        {
+            CLEAR_BIT(RCC->CTLR, CTLR_HSEON_Set);
+            status = RCC_WaitFlag(&RCC->CTLR, CTLR_HSERDY_Set, 0U);
+
+            if (status == HAL_OK)
+            {
+                CLEAR_BIT(RCC->CTLR, CTLR_HSEBYP_Set);
+
+                if (RCC_OscInit->HSEState != RCC_HSE_OFF)
+                {
+                    SET_BIT(RCC->CTLR, RCC_OscInit->HSEState & CTLR_HSEBYP_Set);
+                    SET_BIT(RCC->CTLR, CTLR_HSEON_Set);
+                    status = RCC_WaitFlag(&RCC->CTLR, CTLR_HSERDY_Set, CTLR_HSERDY_Set);
+                }
+            }
+        }
+    }
+
+    /* ---- HSI ---- */
+    if ((status == HAL_OK) && ((RCC_OscInit->OscillatorType & RCC_OSCILLATORTYPE_HSI) != 0U))
+    {
+        if (RCC_OscInit->HSIState == RCC_HSI_ON)
+        {
+            HAL_RCC_AdjustHSICalibrationValue(RCC_OscInit->HSICalibrationValue);
+            SET_BIT(RCC->CTLR, CTLR_HSION_Set);
+            status = RCC_WaitFlag(&RCC->CTLR, CTLR_HSIRDY_Set, CTLR_HSIRDY_Set);
+        }
+        else if (hsi_used)
+        {
+            status = HAL_ERROR;
+        }
+        else
+        {
+            CLEAR_BIT(RCC->CTLR, CTLR_HSION_Set);
+            status = RCC_WaitFlag(&RCC->CTLR, CTLR_HSIRDY_Set, 0U);
+        }
+    }
+
+    /* ---- PLL ---- */
+    if ((status == HAL_OK) && (RCC_OscInit->PLLState != RCC_PLL_NONE))
+    {
+        if (sws == RCC_SYSCLKSource_PLLCLK)
+        {
+            /* Left running, only a request matching it succeeds */
+            if ((RCC_OscInit->PLLState != RCC_PLL_ON) || (RCC_OscInit->PLLSource != (cfgr & CFGR0_PLLSRC_Mask)))
+            {
+                status = HAL_ERROR;
+            }
+        }
+        else
+        {
+            CLEAR_BIT(RCC->CTLR, CTLR_PLLON_Set);
+            status = RCC_WaitFlag(&RCC->CTLR, CTLR_PLLRDY_Set, 0U);
+
+            if ((status == HAL_OK) && (RCC_OscInit->PLLState == RCC_PLL_ON))
+            {
+                /* PLL input must be running */
+                if ((READ_REG(RCC->CTLR) & ((RCC_OscInit->PLLSource == RCC_PLLSource_HSE_MUL2) ? CTLR_HSERDY_Set : CTLR_HSIRDY_Set)) == 0U)
+                {
+                    status = HAL_ERROR;
+                }
+                else
+                {
+                    MODIFY_REG(RCC->CFGR0, CFGR0_PLLSRC_Mask, RCC_OscInit->PLLSource);
+                    SET_BIT(RCC->CTLR, CTLR_PLLON_Set);
+                    status = RCC_WaitFlag(&RCC->CTLR, CTLR_PLLRDY_Set, CTLR_PLLRDY_Set);
+                }
+            }
+        }
+    }
+
+    HAL_BOOT_PHASE_END(RCC_BOOT_PHASE_CLOCK);
+    RCC_ConfigExit();
+
+    return status;
+}
+
+/**
+  * @brief  Switches the system clock source and the AHB prescaler.
+  * @note   Flash wait states are raised before the clock goes up and lowered
+  *         only once it went down (0 up to RCC_FLASH_LATENCY0_MAX_HZ HCLK, 1
+  *         above). Source and prescaler are written in the order that never
+  *         makes HCLK overshoot both the old and the new frequency.
+  *         The source must be running (see HAL_RCC_OscConfig()), the switch
+  *         itself is glitch-free in hardware. HAL_RCC_ClockChanged() is called
+  *         before returning, interrupts stay masked from the first write on.
+  * @param  RCC_ClkInit pointer to a RCC_ClkInitTypeDef structure.
+  * @retval HAL_ERROR if the source is not ready, HAL_TIMEOUT if the switch
+  *         was not acknowledged, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_RCC_ClockConfig(const RCC_ClkInitTypeDef *RCC_ClkInit)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(RCC_ClkInit != NULL);
+    HAL_PARAM_CHECK(IS_RCC_SYSCLKSOURCE(RCC_ClkInit->SYSCLKSource));
+    HAL_PARAM_CHECK(IS_RCC_HCLK(RCC_ClkInit->AHBCLKDivider));
+
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t cfgr = READ_REG(RCC->CFGR0);
+    uint32_t ready = 0x00, sysclk = 0x00, old_sysclk = 0x00, latency = 0x00;
+    uint32_t ms = 0x00;
+
+    switch (RCC_ClkInit->SYSCLKSource)
+    {
+        case RCC_SYSCLKSource_HSE:    ready = CTLR_HSERDY_Set; break;
+        case RCC_SYSCLKSource_PLLCLK: ready = CTLR_PLLRDY_Set; break;
+        default:                      ready = CTLR_HSIRDY_Set; break;
+    }
+
+    RCC_ConfigEnter();
+    HAL_BOOT_PHASE_BEGIN(RCC_BOOT_PHASE_CLOCK);
+
+    if ((READ_REG(RCC->CTLR) & ready) == 0U)
+    {
+        status = HAL_ERROR;
+    }
+    else
+    {
+        old_sysclk = RCC_SysclkFreq((cfgr & CFGR0_SWS_Mask) >> 2, cfgr);
+        sysclk = RCC_SysclkFreq(RCC_ClkInit->SYSCLKSource, cfgr);
+        latency = (RCC_HclkFreq(sysclk, RCC_ClkInit->AHBCLKDivider) > RCC_FLASH_LATENCY0_MAX_HZ) ? FLASH_Latency_1 : FLASH_Latency_0;
+
+        ms = _irq_lock();
+
+        if (latency > (READ_REG(FLASH->ACTLR) & ACTLR_LATENCY_Mask))
+        {
+            MODIFY_REG(FLASH->ACTLR, ACTLR_LATENCY_Mask, latency);
+        }
+
+        if (sysclk > old_sysclk)
+        {
+            MODIFY_REG(RCC->CFGR0, CFGR0_HPRE_Set_Mask, RCC_ClkInit->AHBCLKDivider);
+            MODIFY_REG(RCC->CFGR0, CFGR0_SW_Set_Mask, RCC_ClkInit->SYSCLKSource);
+        }
+        else
+        {
+            MODIFY_REG(RCC->CFGR0, CFGR0_SW_Set_Mask, RCC_ClkInit->SYSCLKSource);
+            MODIFY_REG(RCC->CFGR0, CFGR0_HPRE_Set_Mask, RCC_ClkInit->AHBCLKDivider);
+        }
+
+        status = RCC_WaitFlag(&RCC->CFGR0, CFGR0_SWS_Mask, RCC_ClkInit->SYSCLKSource << 2);
+
+        /* Wait states are only lowered once the new clock is known to be active */
+        if ((status == HAL_OK) && (latency < (READ_REG(FLASH->ACTLR) & ACTLR_LATENCY_Mask)))
+        {
+            MODIFY_REG(FLASH->ACTLR, ACTLR_LATENCY_Mask, latency);
+        }
+
+        /* Re-time the HAL against whatever clock is actually running */
+        HAL_RCC_ClockChanged();
+
+        _irq_unlock(ms);
+    }
+
+    HAL_BOOT_PHASE_END(RCC_BOOT_PHASE_CLOCK);
+    RCC_ConfigExit();
+
+    return status;
+}
+
+/**
+  * @brief  Switches to a predefined clock profile at runtime.
+  * @note   The PLL is started from HSI when needed and stopped when the
+  *         profile does not use it. HAL_RCC_ClockConfig() sets the flash wait
+  *         states, then HAL_RCC_ClockChanged() re-times SysTick, the delay
+  *         helpers and every registered notifier (UART BRR, bit-bang loops,
+  *         input debouncing). Call it from thread context between bursts.
+  *         Refused while another clock configuration is in progress, which
+  *         an interrupt may have preempted.
+  * @param  Profile a value of @ref RCC_Clock_Profile.
+  * @retval HAL_BUSY if a clock configuration is in progress, HAL status otherwise.
+  */
+HAL_StatusTypeDef HAL_RCC_SetProfile(uint32_t Profile)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_RCC_PROFILE(Profile));
+
+    const RCC_ClkInitTypeDef *clk = &RCC_ProfileTable[Profile];
+    RCC_OscInitTypeDef osc = {0};
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t ms = _irq_lock();
+
+    if (RCC_ConfigDepth != 0U)
+    {
+        _irq_unlock(ms);
+        return HAL_BUSY;
+    }
+
+    RCC_ConfigDepth++;
+    _irq_unlock(ms);
+
+    osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    osc.PLLSource = RCC_PLLSource_HSI_MUL2;
+
+    if (clk->SYSCLKSource == RCC_SYSCLKSource_PLLCLK)
+    {
+        osc.PLLState = RCC_PLL_ON;
+        status = HAL_RCC_OscConfig(&osc);
+    }
+
+    if (status == HAL_OK)
+    {
+        status = HAL_RCC_ClockConfig(clk);
+    }
+
+    /* Stop the PLL once unused to cut active power */
+    if ((status == HAL_OK) && (clk->SYSCLKSource != RCC_SYSCLKSource_PLLCLK) &&
+        ((READ_REG(RCC->CTLR) & CTLR_PLLON_Set) != 0U))
+    {
+        osc.PLLState = RCC_PLL_OFF;
+        status = HAL_RCC_OscConfig(&osc);
+    }
+
+    RCC_ConfigExit();
+
+    return status;
+}
+
+/**
+  * @brief  Enables the clock security system on HSE.
+  * @note   On a HSE failure the hardware stops HSE (and a PLL fed by it) and
+  *         switches SYSCLK to HSI, then raises the NMI. HAL_RCC_CSS_IRQHandler()
+  *         only keeps the tick on time and pends the software interrupt,
+  *         HAL_RCC_CSS_Process() then brings up FallbackProfile and re-times
+  *         every notifier. With HAL_RCC_USE_CSS_NMI the software interrupt is
+  *         enabled here at the lowest priority. Call it once HSE runs.
+  * @param  FallbackProfile a value of @ref RCC_Clock_Profile, HSI based.
+  * @retval HAL_ERROR if HSE is not running, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_RCC_EnableCSS(uint32_t FallbackProfile)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_RCC_PROFILE(FallbackProfile));
+
+    if ((READ_REG(RCC->CTLR) & CTLR_HSERDY_Set) == 0U)
+    {
+        return HAL_ERROR;
+    }
+
+    RCC_CSSFallback = FallbackProfile;
+
+#ifdef HAL_RCC_USE_CSS_NMI
+    NVIC_SetPriority(Software_IRQn, RCC_CSS_SWI_PRIORITY);
+    NVIC_EnableIRQ(Software_IRQn);
+#endif /* HAL_RCC_USE_CSS_NMI */
+
+    SET_BIT(RCC->CTLR, RCC_CSSON);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Disables the clock security system.
+  * @retval None
+  */
+void HAL_RCC_DisableCSS(void)
+{
+    CLEAR_BIT(RCC->CTLR, RCC_CSSON);
+}
+
+/**
+  * @brief  Handles a clock security system failure, call it from NMI_Handler.
+  * @note   Defined as NMI_Handler when HAL_RCC_USE_CSS_NMI is set.
+  *         The NMI cannot be masked by _irq_lock(), so it only acknowledges
+  *         the failure and re-times SysTick for the HSI clock selected by
+  *         hardware. The fallback profile and the notifiers are left to
+  *         HAL_RCC_CSS_Process(), through the pended software interrupt.
+  * @retval None
+  */
+void HAL_RCC_CSS_IRQHandler(void)
+{
+    if ((READ_REG(RCC->INTR) & INTR_CSSF_Set) != 0U)
+    {
+        SET_BIT(RCC->INTR, INTR_CSSC_Set);
+        RCC_CSSFailures++;
+
+        HAL_RCC_UpdateClockTree();
+        HAL_TickClockChanged();
+
+        RCC_CSSPending = TRUE;
+        NVIC_SetPendingIRQ(Software_IRQn);
+    }
+}
+
+/**
+  * @brief  Completes a clock security system failure outside the NMI.
+  * @note   Called by SW_Handler when HAL_RCC_USE_CSS_NMI is set,
+  *         otherwise call it from the software interrupt handler or the main
+  *         loop. The fallback profile is applied; if it cannot be reached the
+  *         HAL is still re-timed against HSI. HAL_RCC_CSSCallback() is called
+  *         last. Does nothing when no failure is pending. While a clock
+  *         configuration it preempted is in progress the failure stays
+  *         pending, the software interrupt is pended again once it ends.
+  * @retval None
+  */
+void HAL_RCC_CSS_Process(void)
+{
+    uint32_t ms = _irq_lock();
+
+    if ((RCC_CSSPending == FALSE) || (RCC_ConfigDepth != 0U))
+    {
+        _irq_unlock(ms);
+        return;
+    }
+
+    RCC_CSSPending = FALSE;
+    _irq_unlock(ms);
+
+    if (HAL_RCC_SetProfile(RCC_CSSFallback) != HAL_OK)
+    {
+        HAL_RCC_ClockChanged();
+    }
+
+    HAL_RCC_CSSCallback();
+}
+
+/**
+  * @brief  Clock security system failure callback.
+  * @note   Runs from HAL_RCC_CSS_Process() with the fallback clock active.
+  * @retval None
+  */
+__weak void HAL_RCC_CSSCallback(void)
+{
+    /* NOTE: This function should not be modified, when the callback is needed,
+            the HAL_RCC_CSSCallback could be implemented in the user file
+    */
+}
+
+/**
+  * @brief  Number of HSE failures handled since reset.
+  * @retval failure count
+  */
+uint32_t HAL_RCC_GetCSSFailures(void)
+{
+    return RCC_CSSFailures;
+}
+
+#ifdef HAL_RCC_USE_CSS_NMI
+/**
+  * @brief  NMI handler, defined when HAL_RCC_USE_CSS_NMI is set.
+  * @retval None
+  */
+HAL_IRQ_FAST
+void NMI_Handler(void)
+{
+    HAL_ISR_ENTER(NonMaskableInt_IRQn);
+
+    HAL_RCC_CSS_IRQHandler();
+
+    HAL_ISR_EXIT(NonMaskableInt_IRQn);
+}
+
+/**
+  * @brief  Software interrupt handler, defined when HAL_RCC_USE_CSS_NMI is set.
+  * @retval None
+  */
+HAL_IRQ_FAST
+void SW_Handler(void)
+{
+    HAL_ISR_ENTER(Software_IRQn);
+
+    HAL_RCC_CSS_Process();
+
+    HAL_ISR_EXIT(Software_IRQn);
+}
+#endif /* HAL_RCC_USE_CSS_NMI */
+
+/**
+  * @brief  Decodes the clock frequencies from the RCC registers.
+  * @note   The result of this function could be not correct when using
   *        fractional value for HSE crystal.
+  *        Hot paths should use the cached getters (HAL_RCC_GetHCLKFreq(), ...).
   * @param   RCC_Clocks pointer to a RCC_ClocksTypeDef structure which will hold
   *        the clocks frequencies.
   * @retval none
@@ -80,37 +563,13 @@ void HAL_RCC_GetClocksFreq(RCC_ClocksTypeDef *RCC_Clocks)
     uint32_t cfgr    = READ_REG(RCC->CFGR0);
     uint32_t sysclk  = HSI_VALUE;
     uint32_t hclk, pclk;
-    uint32_t sws     = (cfgr & CFGR0_SWS_Mask);                /* 0x00=HSI, 0x04=HSE, 0x08=PLL */
-    uint32_t hpre_cd = (cfgr & CFGR0_HPRE_Set_Mask) >> 4;      /* 0..15 */
     uint32_t adc_cd  = (cfgr & CFGR0_ADCPRE_Set_Mask) >> 11;   /* 0..19 (5-bit) */
-    uint32_t presc;
 
     /* ---- SYSCLK source ---- */
-    switch (sws)
-    {
-        case 0x00: /* HSI */
-            sysclk = HSI_VALUE;
-            break;
-        case 0x04: /* HSE */
-            sysclk = HSE_VALUE;
-            break;
-        case 0x08: /* PLL = (PLLSRC ? HSE : HSI) * 2 */
-        {
-            uint32_t pllsrc = (cfgr & CFGR0_PLLSRC_Mask);
-            sysclk = (pllsrc ? HSE_VALUE : HSI_VALUE) * 2U;
-            break;
-        }
-        default:
-            sysclk = HSI_VALUE;
-            break;
-    }
+    sysclk = RCC_SysclkFreq((cfgr & CFGR0_SWS_Mask) >> 2, cfgr);
 
     /* ---- HCLK = SYSCLK / AHB prescaler ---- */
-    presc = APBAHBPrescTable[hpre_cd & 0x0F];
-    if (hpre_cd < 8U)
-        hclk = sysclk / presc;
-    else
-        hclk = sysclk >> presc;
+    hclk = RCC_HclkFreq(sysclk, cfgr);
 
     pclk = hclk;
 
@@ -146,11 +605,25 @@ void HAL_RCC_MCOConfig(uint32_t RCC_MCOx, uint32_t RCC_MCOSource)
 
   if (RCC_MCOx == RCC_MCO1)
   {
-        if (RCC_MCOSource != RCC_MCO_NoClock)
+        if (RCC_MCOSource == RCC_MCO_NoClock)
         {
-            /* Enable clocks for GPIOC, AFIO */
-            __HAL_RCC_GPIOC_CLK_ENABLE();
-            __HAL_RCC_AFIO_CLK_ENABLE();
+            MODIFY_REG(RCC->CFGR0, RCC_CFGR0_MCO, RCC_MCO_NoClock);
+
+            /* Give back the clocks held while MCO was running */
+            if (RCC_MCOActive == TRUE)
+            {
+                RCC_MCOActive = FALSE;
+                (void)HAL_RCC_ClockRelease(RCC_APB2Periph_GPIOC | RCC_APB2Periph_AFIO, 0U);
+            }
+        }
+        else
+        {
+            /* Hold clocks for GPIOC, AFIO while MCO is running */
+            if (RCC_MCOActive == FALSE)
+            {
+                RCC_MCOActive = TRUE;
+                (void)HAL_RCC_ClockAcquire(RCC_APB2Periph_GPIOC | RCC_APB2Periph_AFIO, 0U);
+            }
 
             /* Configure PC4 as MCO output: Alternate Function Push-Pull, High speed */
             GPIO_InitStruct.GPIO_Pin   = MCO_GPIO_PIN;
@@ -182,3 +655,636 @@ void HAL_RCC_AdjustHSICalibrationValue(uint8_t HSICalibrationValue)
     tmpreg |= (uint32_t)HSICalibrationValue << 3;
     WRITE_REG(RCC->CTLR, tmpreg);
 }
+
+/**
+  * @brief  Trims HSI against a reference signal of known frequency.
+  * @note   HCLK cycles are counted over Periods falling-edge to falling-edge
+  *         periods of the reference pin, polled with interrupts masked, and
+  *         HSITRIM is set by successive approximation: 5 measurements plus
+  *         one to pick the closer of the two final neighbours.
+  *         A stream of 0x55 UART bytes is a valid reference with
+  *         RefHz = baud / 2 (falling edges every two bits, frame boundaries
+  *         included).
+  *         SYSCLK must come from HSI (directly or through the PLL), SysTick
+  *         must run and Periods / RefHz must stay below one tick period.
+  *         The pin must be configured as an input by the caller.
+  * @param  GPIOx where x can be (A..D).
+  * @param  GPIO_Pin GPIO_Pin_x where x can be (0..7).
+  * @param  RefHz reference frequency in Hz.
+  * @param  Periods number of reference periods per measurement, at least 1.
+  * @param  ErrorPpm receives the residual error of the selected trim, positive
+  *         when HSI is fast, may be NULL.
+  * @retval HAL_TIMEOUT if the reference stopped toggling (trim restored),
+  *         HAL_ERROR if the residual error exceeds HAL_RCC_HSI_TRIM_MAX_PPM
+  *         or SYSCLK does not come from HSI, HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_RCC_HSIAutoTrim(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint32_t RefHz, uint16_t Periods, int32_t *ErrorPpm)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_GPIO_INSTANCE(GPIOx));
+    HAL_PARAM_CHECK(IS_GPIO_PIN(GPIO_Pin));
+    HAL_PARAM_CHECK((RefHz != 0U) && (Periods != 0U));
+
+    uint32_t cfgr = READ_REG(RCC->CFGR0);
+    uint32_t sws = (cfgr & CFGR0_SWS_Mask) >> 2;
+    uint8_t saved = (uint8_t)((READ_REG(RCC->CTLR) & ~CTLR_HSITRIM_Mask) >> CTLR_HSITRIM_Pos);
+    uint8_t trim = 0x00, bit = 0x00;
+    uint32_t expected = 0x00, measured = 0x00, other = 0x00;
+    int32_t error = 0x00;
+
+    if ((sws == RCC_SYSCLKSource_HSE) || ((sws == RCC_SYSCLKSource_PLLCLK) && ((cfgr & CFGR0_PLLSRC_Mask) != 0U)))
+    {
+        return HAL_ERROR;
+    }
+
+    expected = (uint32_t)(((uint64_t)HAL_RCC_GetHCLKFreq() * Periods) / RefHz);
+
+    /* Successive approximation, a higher trim runs HSI faster */
+    for (bit = 0x10; bit != 0U; bit >>= 1)
+    {
+        HAL_RCC_AdjustHSICalibrationValue(trim | bit);
+
+        measured = RCC_MeasureRef(GPIOx, GPIO_Pin, Periods, expected);
+        if (measured == 0U)
+        {
+            HAL_RCC_AdjustHSICalibrationValue(saved);
+            return HAL_TIMEOUT;
+        }
+
+        /* Too few cycles per reference period: HSI still slow */
+        if (measured <= expected)
+        {
+            trim |= bit;
+        }
+    }
+
+    /* trim is the fastest setting not above the reference, compare with the next one */
+    HAL_RCC_AdjustHSICalibrationValue(trim);
+    measured = RCC_MeasureRef(GPIOx, GPIO_Pin, Periods, expected);
+
+    if ((trim < CTLR_HSITRIM_Max) && (measured != 0U))
+    {
+        HAL_RCC_AdjustHSICalibrationValue(trim + 1U);
+        other = RCC_MeasureRef(GPIOx, GPIO_Pin, Periods, expected);
+
+        if ((other != 0U) && (RCC_AbsDiff(other, expected) < RCC_AbsDiff(measured, expected)))
+        {
+            trim++;
+            measured = other;
+        }
+
+        HAL_RCC_AdjustHSICalibrationValue(trim);
+    }
+
+    if (measured == 0U)
+    {
+        HAL_RCC_AdjustHSICalibrationValue(saved);
+        return HAL_TIMEOUT;
+    }
+
+    error = RCC_ErrorPpm(measured, expected);
+
+    if (ErrorPpm != NULL)
+    {
+        *ErrorPpm = error;
+    }
+
+    return ((error <= HAL_RCC_HSI_TRIM_MAX_PPM) && (error >= -HAL_RCC_HSI_TRIM_MAX_PPM)) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+  * @brief  Takes a reference on peripheral clocks, enabling the ones not yet running.
+  * @note   Every clock whose count leaves zero is enabled with a single write
+  *         per bus. Each acquire must be balanced by HAL_RCC_ClockRelease().
+  *         Clocks already running on the first acquire or release (startup
+  *         code, __HAL_RCC_xxx_CLK_ENABLE()) start with one reference that is
+  *         never dropped, so they are never gated by this module.
+  * @param  APB2Periph any combination of RCC_APB2Periph_REFCOUNTED bits.
+  * @param  APB1Periph any combination of RCC_APB1Periph_REFCOUNTED bits.
+  * @retval HAL_ERROR if a count is saturated (that clock is left unchanged),
+  *         HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_RCC_ClockAcquire(uint32_t APB2Periph, uint32_t APB1Periph)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_RCC_REFCOUNTED(APB2Periph, APB1Periph));
+
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t enable2 = 0x00, enable1 = 0x00, index = 0x00, ms = 0x00;
+
+    ms = _irq_lock();
+
+    RCC_RefSeed();
+
+    for (index = 0x00; index < RCC_REF_CLOCK_COUNT; index++)
+    {
+        if (((index < RCC_REF_APB2_COUNT) ? APB2Periph : APB1Periph) & RCC_RefClock[index])
+        {
+            if (RCC_RefCount[index] == 0xFFU)
+            {
+                status = HAL_ERROR;
+            }
+            else if (RCC_RefCount[index]++ == 0U)
+            {
+                if (index < RCC_REF_APB2_COUNT) { enable2 |= RCC_RefClock[index]; }
+                else                            { enable1 |= RCC_RefClock[index]; }
+            }
+        }
+    }
+
+    if (enable2 != 0U)
+    {
+        SET_BIT(RCC->APB2PCENR, enable2);
+        (void)READ_REG(RCC->APB2PCENR);
+    }
+
+    if (enable1 != 0U)
+    {
+        SET_BIT(RCC->APB1PCENR, enable1);
+        (void)READ_REG(RCC->APB1PCENR);
+    }
+
+    _irq_unlock(ms);
+
+    return status;
+}
+
+/**
+  * @brief  Drops a reference on peripheral clocks, gating the ones no longer used.
+  * @note   Every clock whose count reaches zero is disabled with a single
+  *         write per bus.
+  * @param  APB2Periph any combination of RCC_APB2Periph_REFCOUNTED bits.
+  * @param  APB1Periph any combination of RCC_APB1Periph_REFCOUNTED bits.
+  * @retval HAL_ERROR if a clock was not acquired (that clock is left
+  *         unchanged), HAL_OK otherwise.
+  */
+HAL_StatusTypeDef HAL_RCC_ClockRelease(uint32_t APB2Periph, uint32_t APB1Periph)
+{
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_RCC_REFCOUNTED(APB2Periph, APB1Periph));
+
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t disable2 = 0x00, disable1 = 0x00, index = 0x00, ms = 0x00;
+
+    ms = _irq_lock();
+
+    RCC_RefSeed();
+
+    for (index = 0x00; index < RCC_REF_CLOCK_COUNT; index++)
+    {
+        if (((index < RCC_REF_APB2_COUNT) ? APB2Periph : APB1Periph) & RCC_RefClock[index])
+        {
+            if (RCC_RefCount[index] == 0U)
+            {
+                status = HAL_ERROR;
+            }
+            else if (--RCC_RefCount[index] == 0U)
+            {
+                if (index < RCC_REF_APB2_COUNT) { disable2 |= RCC_RefClock[index]; }
+                else                            { disable1 |= RCC_RefClock[index]; }
+            }
+        }
+    }
+
+    if (disable2 != 0U)
+    {
+        CLEAR_BIT(RCC->APB2PCENR, disable2);
+    }
+
+    if (disable1 != 0U)
+    {
+        CLEAR_BIT(RCC->APB1PCENR, disable1);
+    }
+
+    _irq_unlock(ms);
+
+    return status;
+}
+
+/**
+  * @brief  Reset cause of the last reset.
+  * @note   RSTSCKR is read and cleared (RMVF) on the first call, the value is
+  *         kept for later calls, so the cause of the current boot stays
+  *         available and the next reset starts from clean flags.
+  * @retval any combination of @ref RCC_Reset_Flags
+  */
+uint32_t HAL_RCC_GetResetFlags(void)
+{
+    uint32_t ms = _irq_lock();
+
+    if (RCC_ResetFlagsRead == FALSE)
+    {
+        RCC_ResetFlags = READ_REG(RCC->RSTSCKR) & RCC_RESET_ALL;
+        SET_BIT(RCC->RSTSCKR, RSTSCKR_RMVF_Set);
+        RCC_ResetFlagsRead = TRUE;
+    }
+
+    _irq_unlock(ms);
+
+    return RCC_ResetFlags;
+}
+
+#ifdef HAL_USE_BOOT_PROFILE
+/**
+  * @brief  Starts the boot profile, call it first thing in main().
+  * @note   The reset flags are latched. When SysTick is not running yet it is
+  *         started as a free running HCLK counter without interrupt, so the
+  *         phases before HAL_TickInit() are timed too.
+  *         Cycles are counted at the HCLK running at the time, phases
+  *         spanning a clock change mix both frequencies.
+  * @retval None
+  */
+void HAL_RCC_BootProfileStart(void)
+{
+    uint32_t index = 0x00;
+
+    if ((READ_REG(SysTick->CTLR) & RCC_SYSTICK_STE) == 0U)
+    {
+        CLEAR_REG(SysTick->CNT);
+        WRITE_REG(SysTick->CMP, 0xFFFFFFFFU);
+        WRITE_REG(SysTick->CTLR, RCC_SYSTICK_STE | RCC_SYSTICK_STCLK | RCC_SYSTICK_STRE);
+    }
+
+    RCC_BootReport.ResetFlags = HAL_RCC_GetResetFlags();
+    RCC_BootReport.TotalCycles = 0U;
+
+    for (index = 0x00; index < RCC_BOOT_PHASE_COUNT; index++)
+    {
+        RCC_BootReport.PhaseCycles[index] = 0U;
+        RCC_BootPhaseDepth[index] = 0U;
+    }
+
+    RCC_BootProfiling = TRUE;
+    RCC_BootStart = HAL_GetCycles();
+}
+
+/**
+  * @brief  Marks the start of a boot phase.
+  * @note   Phases nest: time spent in an inner phase is counted in it and
+  *         in every enclosing phase. A phase nested in itself (a clock change
+  *         made by HAL_RCC_SetProfile(), a driver call inside an application
+  *         phase) keeps a depth count and is timed once, from the outermost
+  *         begin to the matching end. Ignored once the profile is ended.
+  * @param  Phase a value of @ref RCC_BootPhaseTypeDef.
+  * @retval None
+  */
+void HAL_RCC_BootPhaseBegin(RCC_BootPhaseTypeDef Phase)
+{
+    if ((RCC_BootProfiling == FALSE) || (Phase >= RCC_BOOT_PHASE_COUNT) ||
+        (RCC_BootPhaseDepth[Phase] == 0xFFU))
+    {
+        return;
+    }
+
+    if (RCC_BootPhaseDepth[Phase]++ == 0U)
+    {
+        RCC_BootPhaseStart[Phase] = HAL_GetCycles();
+    }
+}
+
+/**
+  * @brief  Marks the end of a boot phase, the elapsed cycles are accumulated
+  *         when the outermost begin of the phase is closed.
+  * @param  Phase a value of @ref RCC_BootPhaseTypeDef.
+  * @retval None
+  */
+void HAL_RCC_BootPhaseEnd(RCC_BootPhaseTypeDef Phase)
+{
+    if ((RCC_BootProfiling == FALSE) || (Phase >= RCC_BOOT_PHASE_COUNT) ||
+        (RCC_BootPhaseDepth[Phase] == 0U))
+    {
+        return;
+    }
+
+    if (--RCC_BootPhaseDepth[Phase] == 0U)
+    {
+        RCC_BootReport.PhaseCycles[Phase] += HAL_GetCycles() - RCC_BootPhaseStart[Phase];
+    }
+}
+
+/**
+  * @brief  Ends the boot profile, later phase stamps are ignored.
+  * @retval None
+  */
+void HAL_RCC_BootProfileEnd(void)
+{
+    if (RCC_BootProfiling == TRUE)
+    {
+        RCC_BootReport.TotalCycles = HAL_GetCycles() - RCC_BootStart;
+        RCC_BootProfiling = FALSE;
+    }
+}
+
+/**
+  * @brief  Boot report filled by the profiler.
+  * @retval pointer to the report, complete after HAL_RCC_BootProfileEnd().
+  */
+const RCC_BootReportTypeDef *HAL_RCC_GetBootReport(void)
+{
+    return &RCC_BootReport;
+}
+#endif /* HAL_USE_BOOT_PROFILE */
+
+/**
+  * @brief  Register a callback to be notified after every system clock change.
+  * @param  Notifier pointer to a caller owned RCC_ClockNotifierTypeDef with
+  *         Callback (and optionally Context) filled in.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_RCC_RegisterClockNotifier(RCC_ClockNotifierTypeDef *Notifier)
+{
+    RCC_ClockNotifierTypeDef *node;
+    uint32_t ms;
+
+    if ((Notifier == NULL) || (Notifier->Callback == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+
+    /* Already registered */
+    for (node = RCC_NotifierList; node != NULL; node = node->Next)
+    {
+        if (node == Notifier)
+        {
+            _irq_unlock(ms);
+            return HAL_OK;
+        }
+    }
+
+    Notifier->Next = RCC_NotifierList;
+    RCC_NotifierList = Notifier;
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Remove a previously registered clock change notifier.
+  * @param  Notifier pointer to the notifier to remove.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_RCC_UnregisterClockNotifier(RCC_ClockNotifierTypeDef *Notifier)
+{
+    RCC_ClockNotifierTypeDef **link;
+    HAL_StatusTypeDef status = HAL_ERROR;
+    uint32_t ms;
+
+    if (Notifier == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+
+    for (link = &RCC_NotifierList; *link != NULL; link = &(*link)->Next)
+    {
+        if (*link == Notifier)
+        {
+            *link = Notifier->Next;
+            Notifier->Next = NULL;
+            status = HAL_OK;
+            break;
+        }
+    }
+
+    _irq_unlock(ms);
+
+    return status;
+}
+
+/**
+  * @brief  Propagate a system clock change to the HAL.
+  * @note   Must be called after RCC->CFGR0 has been modified. SystemCoreClock is
+  *         updated, the SysTick period is rescaled, then every registered
+  *         notifier is called. The whole sequence runs with interrupts masked,
+  *         so no timeout or baud rate is ever evaluated against mixed clocks.
+  * @retval none
+  */
+void HAL_RCC_ClockChanged(void)
+{
+    RCC_ClockNotifierTypeDef *node;
+    uint32_t ms;
+
+    ms = _irq_lock();
+
+    HAL_RCC_UpdateClockTree();
+
+    HAL_TickClockChanged();
+
+    for (node = RCC_NotifierList; node != NULL; node = node->Next)
+    {
+        node->Callback(&RCC_ClockTree, node->Context);
+    }
+
+    _irq_unlock(ms);
+}
+
+/**
+  * @brief  Reload the clock tree cache and SystemCoreClock from the RCC registers.
+  * @note   Called by the cached getters on first use and by HAL_TickInit()
+  *         so the cache matches the clock set up by the startup code. Does
+  *         not re-time anything, use
+  *         HAL_RCC_ClockChanged() after a clock change.
+  * @retval none
+  */
+void HAL_RCC_UpdateClockTree(void)
+{
+    RCC_ClocksTypeDef clocks;
+    uint32_t ms;
+
+    HAL_RCC_GetClocksFreq(&clocks);
+
+    ms = _irq_lock();
+    RCC_ClockTree = clocks;
+    SystemCoreClock = clocks.HCLK_Frequency;
+    _irq_unlock(ms);
+}
+
+/* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Waits for RCC flag bits to reach a state.
+  * @note   Bounded by HAL_RCC_STARTUP_TIMEOUT_US worth of SysTick cycles once
+  *         SysTick runs, by HAL_RCC_STARTUP_TIMEOUT polls before HAL_TickInit().
+  *         The cycles are sampled on CNT, not on the tick interrupt, so the
+  *         bound also holds inside _irq_lock() sections (ClockConfig, the CSS
+  *         software interrupt, the Standby exit).
+  * @param  Reg RCC register holding the flags (CTLR or CFGR0).
+  * @param  Flag flag bits to watch.
+  * @param  State expected value of the Flag bits.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef RCC_WaitFlag(__IO uint32_t *Reg, uint32_t Flag, uint32_t State)
+{
+    HAL_TickSpanTypeDef span;
+    uint32_t count = HAL_RCC_STARTUP_TIMEOUT;
+    uint32_t budget = (uint32_t)(((uint64_t)HAL_RCC_STARTUP_TIMEOUT_US * SystemCoreClock) / 1000000U);
+    uint32_t ticking = ((READ_REG(SysTick->CTLR) & RCC_SYSTICK_STE) != 0U) ? TRUE : FALSE;
+
+    if (ticking == TRUE)
+    {
+        HAL_TickSpanStart(&span);
+    }
+
+    while ((READ_REG(*Reg) & Flag) != State)
+    {
+        if ((ticking == TRUE) ? (HAL_TickSpanElapsed(&span) >= budget) : (--count == 0U))
+        {
+            return HAL_TIMEOUT;
+        }
+    }
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  SYSCLK frequency for a clock source.
+  * @param  Source a value of @ref System_clock_source.
+  * @param  Cfgr0 RCC->CFGR0 value providing the PLL source.
+  * @retval frequency in Hz
+  */
+static uint32_t RCC_SysclkFreq(uint32_t Source, uint32_t Cfgr0)
+{
+    switch (Source)
+    {
+        case RCC_SYSCLKSource_HSE:
+            return HSE_VALUE;
+        case RCC_SYSCLKSource_PLLCLK: /* PLL = (PLLSRC ? HSE : HSI) * 2 */
+            return (((Cfgr0 & CFGR0_PLLSRC_Mask) != 0U) ? HSE_VALUE : HSI_VALUE) * 2U;
+        default:
+            return HSI_VALUE;
+    }
+}
+
+/**
+  * @brief  HCLK frequency for a SYSCLK frequency and an AHB prescaler.
+  * @param  Sysclk SYSCLK frequency in Hz.
+  * @param  Cfgr0 value holding the HPRE field (RCC->CFGR0 or a RCC_SYSCLK_Divx value).
+  * @retval frequency in Hz
+  */
+static uint32_t RCC_HclkFreq(uint32_t Sysclk, uint32_t Cfgr0)
+{
+    uint32_t hpre_cd = (Cfgr0 & CFGR0_HPRE_Set_Mask) >> 4;     /* 0..15 */
+    uint32_t presc = APBAHBPrescTable[hpre_cd];
+
+    return (hpre_cd < 8U) ? (Sysclk / presc) : (Sysclk >> presc);
+}
+
+/**
+  * @brief  Counts HCLK cycles over reference periods, falling edge to falling edge.
+  * @param  GPIOx reference port.
+  * @param  GPIO_Pin reference pin.
+  * @param  Periods number of periods to time.
+  * @param  Timeout polling iterations allowed per level, at least the
+  *         expected window length in cycles.
+  * @retval cycle count, 0 on timeout.
+  */
+static uint32_t RCC_MeasureRef(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint16_t Periods, uint32_t Timeout)
+{
+    uint32_t start = 0x00, end = 0x00, count = 0x00, ms = 0x00;
+    uint32_t edge = 0x00;
+
+    ms = _irq_lock();
+
+    /* edge 0 synchronizes on the first falling edge, the clock starts there */
+    for (edge = 0x00; edge <= Periods; edge++)
+    {
+        for (count = Timeout; ((READ_REG(GPIOx->INDR) & GPIO_Pin) == 0U) && (count != 0U); count--) { }
+        for (; ((READ_REG(GPIOx->INDR) & GPIO_Pin) != 0U) && (count != 0U); count--) { }
+
+        if (count == 0U)
+        {
+            _irq_unlock(ms);
+            return 0U;
+        }
+
+        if (edge == 0U)
+        {
+            start = HAL_GetCycles();
+        }
+    }
+
+    end = HAL_GetCycles();
+
+    _irq_unlock(ms);
+
+    return end - start;
+}
+
+/**
+  * @brief  Relative error of a measurement.
+  * @retval (Measured - Expected) / Expected in ppm.
+  */
+static int32_t RCC_ErrorPpm(uint32_t Measured, uint32_t Expected)
+{
+    return (int32_t)((((int64_t)Measured - (int64_t)Expected) * 1000000) / (int64_t)Expected);
+}
+
+/**
+  * @brief  Distance between two cycle counts.
+  * @retval |A - B|
+  */
+static uint32_t RCC_AbsDiff(uint32_t A, uint32_t B)
+{
+    return (A > B) ? (A - B) : (B - A);
+}
+
+/**
+  * @brief  Gives one reference to every counted clock found running on first use.
+  * @note   Called with interrupts masked.
+  * @retval None
+  */
+static void RCC_RefSeed(void)
+{
+    uint32_t apb2 = 0x00, apb1 = 0x00, index = 0x00;
+
+    if (RCC_RefSeeded == TRUE)
+    {
+        return;
+    }
+
+    RCC_RefSeeded = TRUE;
+    apb2 = READ_REG(RCC->APB2PCENR);
+    apb1 = READ_REG(RCC->APB1PCENR);
+
+    for (index = 0x00; index < RCC_REF_CLOCK_COUNT; index++)
+    {
+        if ((((index < RCC_REF_APB2_COUNT) ? apb2 : apb1) & RCC_RefClock[index]) != 0U)
+        {
+            RCC_RefCount[index] = 1U;
+        }
+    }
+}
+
+/**
+  * @brief  Marks a clock configuration in progress.
+  * @retval None
+  */
+static void RCC_ConfigEnter(void)
+{
+    uint32_t ms = _irq_lock();
+
+    RCC_ConfigDepth++;
+
+    _irq_unlock(ms);
+}
+
+/**
+  * @brief  Ends a clock configuration, pends a CSS failure it deferred.
+  * @retval None
+  */
+static void RCC_ConfigExit(void)
+{
+    uint32_t ms = _irq_lock();
+
+    RCC_ConfigDepth--;
+
+    if ((RCC_ConfigDepth == 0U) && (RCC_CSSPending != FALSE))
+    {
+        NVIC_SetPendingIRQ(Software_IRQn);
+    }
+
+    _irq_unlock(ms);
+}
@@ -16,31 +16,129 @@
 #define HAL_TICK_DEFAULT_HZ   1000u   /* 1 kHz = 1 ms/tick */
 #endif
 
+#if ((HAL_TICK_DEFAULT_HZ != 10u) && (HAL_TICK_DEFAULT_HZ != 100u) && (HAL_TICK_DEFAULT_HZ != 1000u))
+#error "HAL_TICK_DEFAULT_HZ must be 10, 100 or 1000"
+#endif
+
 #define SYSTICK_STE_BIT     (1u << 0)   /* enable counter */
 #define SYSTICK_STIE_BIT    (1u << 1)   /* interrupt enable */
 #define SYSTICK_STCLK_BIT   (1u << 2)   /* counter clock source HCLK */
 #define SYSTICK_STRE_BIT    (1u << 3)   /* auto-reload */
+
+#define SYSTICK_CNTIF_BIT   (1u << 0)   /* counter reached CMP */
 /* Private macro -------------------------------------------------------------*/
+/* CNT counts 0..CMP, so one SysTick period is CMP + 1 cycles */
+#define SYSTICK_PERIOD()    (READ_REG(SysTick->CMP) + 1u)
 /* Private variables ---------------------------------------------------------*/
 static volatile uint32_t uwTick = 0;
+static volatile uint32_t uwTickCycles = 0;   /* SysTick cycles elapsed up to the last tick interrupt */
+static HAL_TickFreqTypeDef uwTickFreq = (HAL_TickFreqTypeDef)(1000u / HAL_TICK_DEFAULT_HZ);
+static volatile uint32_t uwTickCount = 0;      /* number of tick interrupts served */
+static volatile uint32_t uwTickOverruns = 0;   /* tick interrupts that lasted longer than a tick */
+static TICK_TaskTypeDef *TickTaskList = NULL;
 /* Private function prototypes -----------------------------------------------*/
+static uint32_t TICK_ComputeCmp(void);
+static void TICK_RunTasks(void);
 /* Exported functions ---------------------------------------------------------*/
 /**
-  * @brief  Initialize SysTick at 1000Hz, period 1ms
+  * @brief  Initialize SysTick at the current tick frequency (HAL_TICK_DEFAULT_HZ at reset)
+  * @note   The RCC clock tree cache and SystemCoreClock are reloaded first.
+  *         Cycles already counted by a free-running SysTick (boot profiler)
+  *         are kept in HAL_GetCycles().
   * @retval none
   */
 void HAL_TickInit(void)
 {
-    uint32_t cmp = SystemCoreClock / HAL_TICK_DEFAULT_HZ;
+    uint32_t cmp = 0x00;
 
-    if (cmp == 0u) cmp = 1u;
+    HAL_BOOT_PHASE_BEGIN(RCC_BOOT_PHASE_TICK);
+
+    HAL_RCC_UpdateClockTree();
+    cmp = TICK_ComputeCmp();
 
     CLEAR_REG(SysTick->CTLR);     /* stop */
+    uwTickCycles += READ_REG(SysTick->CNT);   /* keep HAL_GetCycles() monotonic */
+    if ((READ_REG(SysTick->SR) & SYSTICK_CNTIF_BIT) != 0u)
+    {
+        uwTickCycles += SYSTICK_PERIOD();     /* wrap no interrupt will account for */
+    }
     CLEAR_REG(SysTick->CNT);     /* clear counter */
     CLEAR_REG(SysTick->SR);     /* clear flag */
     WRITE_REG(SysTick->CMP, cmp);   /* period */
     WRITE_REG(SysTick->CTLR, SYSTICK_STE_BIT | SYSTICK_STIE_BIT | SYSTICK_STCLK_BIT | SYSTICK_STRE_BIT);
     NVIC_EnableIRQ(SysTicK_IRQn);
+
+    HAL_BOOT_PHASE_END(RCC_BOOT_PHASE_TICK);
+}
+
+/**
+  * @brief  Set a new tick frequency, SysTick period is recomputed from SystemCoreClock.
+  * @note   HAL_GetTick() keeps counting in milliseconds, only its resolution changes.
+  * @param  Freq tick frequency, a value of @ref HAL_TickFreqTypeDef
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SetTickFreq(HAL_TickFreqTypeDef Freq)
+{
+    HAL_PARAM_CHECK(IS_TICK_FREQ(Freq));
+
+    uint32_t ms = _irq_lock();
+
+    uwTickFreq = Freq;
+    HAL_TickClockChanged();
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Return the current tick frequency.
+  * @retval tick frequency, a value of @ref HAL_TickFreqTypeDef
+  */
+HAL_TickFreqTypeDef HAL_GetTickFreq(void)
+{
+    return uwTickFreq;
+}
+
+/**
+  * @brief  Rescale the SysTick period after SystemCoreClock or the tick frequency changed.
+  * @note   The elapsed part of the current period is scaled too, so the next
+  *         tick interrupt keeps its phase. The cycles removed from (or added
+  *         to) CNT are moved into the cycle base so HAL_GetCycles() stays
+  *         monotonic. Called by HAL_RCC_ClockChanged().
+  *         Before HAL_TickInit() (tick interrupt disabled) SysTick is left
+  *         alone: the boot profiler keeps its free-running count and
+  *         HAL_TickInit() picks up the new clock.
+  * @retval none
+  */
+void HAL_TickClockChanged(void)
+{
+    uint32_t ms = _irq_lock();
+    uint32_t old_cmp = READ_REG(SysTick->CMP);
+    uint32_t new_cmp = TICK_ComputeCmp();
+    uint32_t old_cnt, new_cnt;
+
+    if ((READ_REG(SysTick->CTLR) & SYSTICK_STIE_BIT) == 0u)
+    {
+        _irq_unlock(ms);
+        return;
+    }
+
+    old_cnt = READ_REG(SysTick->CNT);
+    new_cnt = (uint32_t)(((uint64_t)old_cnt * ((uint64_t)new_cmp + 1u)) / ((uint64_t)old_cmp + 1u));
+
+    WRITE_REG(SysTick->CMP, new_cmp);
+    WRITE_REG(SysTick->CNT, new_cnt);
+    uwTickCycles += old_cnt - new_cnt;
+
+    /* A wrap already pending was counted with the old period, the tick
+       interrupt will add the new one */
+    if ((READ_REG(SysTick->SR) & SYSTICK_CNTIF_BIT) != 0u)
+    {
+        uwTickCycles += old_cmp - new_cmp;
+    }
+
+    _irq_unlock(ms);
 }
 
 /**
@@ -65,14 +163,18 @@ uint32_t HAL_GetTick(void)
   */
 void HAL_Delay(uint32_t Delay)
 {
-    uint32_t start = HAL_GetTick();
+    HAL_DeadlineTypeDef deadline;
 
-    while ((uint32_t)(HAL_GetTick() - start) < Delay) { __asm volatile("nop"); }
+    HAL_DeadlineStart(&deadline, Delay);
+
+    while (HAL_DeadlineExpired(&deadline) == FALSE) { __asm volatile("nop"); }
 }
 
 /**
   * @brief This function provides minimum delay (in microseconds) based
   *        on variable incremented.
+  * @note  SysTick CNT is sampled directly so the delay also works with
+  *        interrupts masked.
   * @param Delay specifies the delay time length, in microseconds.
   * @retval None
   */
@@ -80,23 +182,56 @@ void HAL_DelayUs(uint32_t Delay)
 {
     if (Delay == 0u) return;
 
-    uint32_t need = ((uint32_t)Delay * (uint32_t)SystemCoreClock) / 1000000ull;
+    uint32_t need = (uint32_t)(((uint64_t)Delay * (uint64_t)SystemCoreClock) / 1000000ull);
 
-    if (need == 0ull) need = 1ull;
+    if (need == 0u) need = 1u;
 
-    uint32_t cmp  = READ_REG(SysTick->CMP); if (cmp == 0u) cmp = 1u;
-    uint32_t last = READ_REG(SysTick->CNT);
-    uint32_t acc  = 0ull;
+    HAL_DelayCycles(need);
+}
 
-    while (1)
-    {
-        uint32_t now = READ_REG(SysTick->CNT);
-        uint32_t delta = (now >= last) ? (now - last) : ((cmp - last) + now);
-        acc += (uint32_t)delta;
-        last = now;
+/**
+  * @brief  Waits for at least Cycles HCLK cycles, counted on SysTick.
+  * @note   Works with interrupts masked. Returns at once for 0 cycles.
+  * @param  Cycles minimum duration in HCLK cycles.
+  * @retval None
+  */
+void HAL_DelayCycles(uint32_t Cycles)
+{
+    HAL_TickSpanTypeDef span;
 
-        if (acc >= need) break;
-    }
+    HAL_TickSpanStart(&span);
+
+    while (HAL_TickSpanElapsed(&span) < Cycles) { }
+}
+
+/**
+  * @brief  Start measuring a span of HCLK cycles on the SysTick counter.
+  * @note   Unlike HAL_GetCycles() it does not need the tick interrupt, so it
+  *         keeps counting with interrupts masked.
+  * @param  Span pointer to the span to initialize.
+  * @retval none
+  */
+void HAL_TickSpanStart(HAL_TickSpanTypeDef *Span)
+{
+    Span->Last = READ_REG(SysTick->CNT);
+    Span->Elapsed = 0u;
+}
+
+/**
+  * @brief  Accumulate the cycles elapsed since the previous sample.
+  * @note   Must be polled at least once per SysTick period, a wrap is
+  *         worth CMP + 1 cycles.
+  * @param  Span pointer to a span started by HAL_TickSpanStart().
+  * @retval HCLK cycles elapsed since HAL_TickSpanStart()
+  */
+uint32_t HAL_TickSpanElapsed(HAL_TickSpanTypeDef *Span)
+{
+    uint32_t now = READ_REG(SysTick->CNT);
+
+    Span->Elapsed += (now >= Span->Last) ? (now - Span->Last) : ((SYSTICK_PERIOD() - Span->Last) + now);
+    Span->Last = now;
+
+    return Span->Elapsed;
 }
 
 /**
@@ -113,12 +248,207 @@ uint8_t HAL_TickExpired(uint32_t start_ms, uint32_t timeout_ms)
 }
 
 /**
-  * @brief Tick count will increase by 1 every 1ms.
+  * @brief  Provides a free running SysTick cycle counter (HCLK cycles).
+  * @note   Wraps after 2^32 cycles (about 89 s at 48 MHz). Safe to call with
+  *         interrupts masked as long as at most one tick interrupt is pending.
+  * @retval cycle count
+  */
+uint32_t HAL_GetCycles(void)
+{
+    uint32_t base, cnt, cnt2, pending;
+
+    do
+    {
+        base    = uwTickCycles;
+        cnt     = READ_REG(SysTick->CNT);
+        pending = READ_REG(SysTick->SR) & SYSTICK_CNTIF_BIT;
+        cnt2    = READ_REG(SysTick->CNT);
+    } while ((base != uwTickCycles) || (cnt2 < cnt));
+
+    /* Counter reloaded but the tick interrupt has not been served yet */
+    if (pending != 0u)
+    {
+        base += SYSTICK_PERIOD();
+    }
+
+    return base + cnt2;
+}
+
+/**
+  * @brief  Start a deadline Timeout milliseconds from now.
+  * @param  Deadline pointer to the deadline to initialize.
+  * @param  Timeout  timeout in milliseconds, HAL_MAX_DELAY never expires and
+  *                  0 is already expired.
+  * @retval none
+  */
+void HAL_DeadlineStart(HAL_DeadlineTypeDef *Deadline, uint32_t Timeout)
+{
+    if (Timeout == HAL_MAX_DELAY)
+    {
+        Deadline->Unit = HAL_DEADLINE_NEVER;
+        Deadline->Start = 0u;
+        Deadline->Timeout = 0u;
+    }
+    else
+    {
+        /* Expired once more than Timeout ticks have elapsed, which guarantees
+           at least Timeout full milliseconds; 0 starts one tick in the past */
+        Deadline->Unit = HAL_DEADLINE_MS;
+        Deadline->Start = (Timeout == 0u) ? (HAL_GetTick() - 1u) : HAL_GetTick();
+        Deadline->Timeout = Timeout;
+    }
+}
+
+/**
+  * @brief  Start a deadline Cycles HCLK cycles from now.
+  * @param  Deadline pointer to the deadline to initialize.
+  * @param  Cycles   timeout in HCLK cycles.
+  * @retval none
+  */
+void HAL_DeadlineStartCycles(HAL_DeadlineTypeDef *Deadline, uint32_t Cycles)
+{
+    Deadline->Unit = HAL_DEADLINE_CYCLES;
+    Deadline->Start = HAL_GetCycles();
+    Deadline->Timeout = Cycles;
+}
+
+/**
+  * @brief  Start a deadline TimeoutUs microseconds from now.
+  * @note   Resolution is one HCLK cycle. Timeouts too long for the cycle
+  *         counter (2^31 cycles, about 44 s at 48 MHz) fall back to a
+  *         millisecond deadline rounded up.
+  * @param  Deadline  pointer to the deadline to initialize.
+  * @param  TimeoutUs timeout in microseconds, HAL_MAX_DELAY never expires.
+  * @retval none
+  */
+void HAL_DeadlineStartUs(HAL_DeadlineTypeDef *Deadline, uint32_t TimeoutUs)
+{
+    uint64_t cycles;
+
+    if (TimeoutUs == HAL_MAX_DELAY)
+    {
+        HAL_DeadlineStart(Deadline, HAL_MAX_DELAY);
+        return;
+    }
+
+    cycles = ((uint64_t)TimeoutUs * (uint64_t)SystemCoreClock) / 1000000ull;
+
+    if (cycles < 0x80000000ull)
+    {
+        HAL_DeadlineStartCycles(Deadline, (uint32_t)cycles);
+    }
+    else
+    {
+        HAL_DeadlineStart(Deadline, (TimeoutUs / 1000u) + 1u);
+    }
+}
+
+/**
+  * @brief  Check a deadline, wrap-safe over the whole 32-bit timeout range.
+  * @param  Deadline pointer to a deadline started by HAL_DeadlineStart*().
+  * @retval TRUE  Deadline has expired.
+  * @retval FALSE Deadline is still ongoing.
+  */
+uint8_t HAL_DeadlineExpired(const HAL_DeadlineTypeDef *Deadline)
+{
+    switch (Deadline->Unit)
+    {
+        case HAL_DEADLINE_MS:
+            return ((uint32_t)(HAL_GetTick() - Deadline->Start) > Deadline->Timeout) ? TRUE : FALSE;
+        case HAL_DEADLINE_CYCLES:
+            return ((uint32_t)(HAL_GetCycles() - Deadline->Start) >= Deadline->Timeout) ? TRUE : FALSE;
+        default:
+            return FALSE;
+    }
+}
+
+/**
+  * @brief  Register a periodic task run from the SysTick interrupt.
+  * @note   Phase is aligned on the global tick count, so two tasks registered
+  *         at different times still keep their relative offsets.
+  * @param  Task pointer to a caller owned TICK_TaskTypeDef with Callback,
+  *         Context, Period and Phase filled in.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_TickTaskRegister(TICK_TaskTypeDef *Task)
+{
+    TICK_TaskTypeDef *node;
+    uint32_t ms;
+
+    if ((Task == NULL) || (Task->Callback == NULL) || (Task->Period == 0u) || (Task->Phase >= Task->Period))
+    {
+        return HAL_ERROR;
+    }
+
+    ms = _irq_lock();
+
+    for (node = TickTaskList; node != NULL; node = node->Next)
+    {
+        if (node == Task)
+        {
+            _irq_unlock(ms);
+            return HAL_BUSY;
+        }
+    }
+
+    /* Ticks until (count % Period) == Phase, a full period if it is right now */
+    Task->Countdown = (uint16_t)((Task->Phase + Task->Period - ((uwTickCount + 1u) % Task->Period)) % Task->Period + 1u);
+    Task->Overruns  = 0u;
+    Task->MaxCycles = 0u;
+    Task->Next      = TickTaskList;
+    TickTaskList    = Task;
+
+    _irq_unlock(ms);
+
+    return HAL_OK;
+}
+
+/**
+  * @brief  Remove a periodic task.
+  * @note   A task callback may remove its own task.
+  * @param  Task pointer to the task to remove.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_TickTaskUnregister(TICK_TaskTypeDef *Task)
+{
+    TICK_TaskTypeDef **link;
+    HAL_StatusTypeDef status = HAL_ERROR;
+    uint32_t ms;
+
+    ms = _irq_lock();
+
+    for (link = &TickTaskList; *link != NULL; link = &(*link)->Next)
+    {
+        if (*link == Task)
+        {
+            *link = Task->Next;
+            Task->Next = NULL;
+            status = HAL_OK;
+            break;
+        }
+    }
+
+    _irq_unlock(ms);
+
+    return status;
+}
+
+/**
+  * @brief  Number of tick interrupts that did not complete within one tick period.
+  * @retval overrun count
+  */
+uint32_t HAL_TickGetOverruns(void)
+{
+    return uwTickOverruns;
+}
+
+/**
+  * @brief Tick count will increase by the tick period (in ms) every tick interrupt.
   * @note This function is declared as __weak to be overwritten in case of other
   *       implementations in user file.
   * @retval none
   */
-__attribute__((weak)) void HAL_IncTick(void) { uwTick++; }
+__attribute__((weak)) void HAL_IncTick(void) { uwTick += (uint32_t)uwTickFreq; }
 
 /**
   * @brief User callback function.
@@ -132,10 +462,74 @@ __attribute__((weak)) void HAL_SysTick_UserCallback(void) {}
   * @brief ISR of SysTick, which will trigger tick count to be increased by 1 every 1ms.
   * @retval none
   */
-__attribute__((interrupt("WCH-Interrupt-fast")))
+HAL_IRQ_FAST
 void SysTick_Handler(void)
 {
+    HAL_ISR_ENTER(SysTicK_IRQn);
+
     CLEAR_REG(SysTick->SR);
+    uwTickCycles += SYSTICK_PERIOD();
+    uwTickCount++;
     HAL_IncTick();
+    TICK_RunTasks();
     HAL_SysTick_UserCallback();
+
+    /* Next tick already pending: this interrupt took a whole tick period */
+    if ((READ_REG(SysTick->SR) & SYSTICK_CNTIF_BIT) != 0u)
+    {
+        uwTickOverruns++;
+    }
+
+    HAL_ISR_EXIT(SysTicK_IRQn);
+}
+
+/* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Compute the SysTick compare value for the current clock and tick frequency.
+  * @retval SysTick CMP value (one period minus one cycle)
+  */
+static uint32_t TICK_ComputeCmp(void)
+{
+    uint32_t period = (SystemCoreClock / 1000u) * (uint32_t)uwTickFreq;
+
+    if (period < 2u) period = 2u;
+
+    return period - 1u;
+}
+
+/**
+  * @brief  Run the periodic tasks due on this tick and track their execution time.
+  * @retval none
+  */
+static void TICK_RunTasks(void)
+{
+    TICK_TaskTypeDef *task, *next;
+    uint32_t start, elapsed;
+
+    for (task = TickTaskList; task != NULL; task = next)
+    {
+        /* Read before the callback, which may unregister its own task */
+        next = task->Next;
+
+        if (--task->Countdown != 0u)
+        {
+            continue;
+        }
+
+        task->Countdown = task->Period;
+
+        start = HAL_GetCycles();
+        task->Callback(task->Context);
+        elapsed = HAL_GetCycles() - start;
+
+        if (elapsed > task->MaxCycles)
+        {
+            task->MaxCycles = elapsed;
+        }
+
+        if ((elapsed > (uint32_t)task->Period * SYSTICK_PERIOD()) && (task->Overruns != 0xFFFFu))
+        {
+            task->Overruns++;
+        }
+    }
 }
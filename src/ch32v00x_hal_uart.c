@@ -18,16 +18,24 @@
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 static HAL_StatusTypeDef UART_WaitOnFlagUntilTimeout(UART_HandleTypeDef *huart, uint32_t Flag, FlagStatus Status,
-                                                     uint32_t Tickstart, uint32_t Timeout);
+                                                     const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size,
+                                       const HAL_DeadlineTypeDef *Deadline);
+static HAL_StatusTypeDef UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size,
+                                      const HAL_DeadlineTypeDef *Deadline);
 static HAL_StatusTypeDef UART_Start_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
 static void UART_EndRxTransfer(UART_HandleTypeDef *huart);
 static HAL_StatusTypeDef UART_Transmit_IT(UART_HandleTypeDef *huart);
 static HAL_StatusTypeDef UART_EndTransmit_IT(UART_HandleTypeDef *huart);
 static HAL_StatusTypeDef UART_Receive_IT(UART_HandleTypeDef *huart);
+static void UART_SetBaudRate(UART_HandleTypeDef *huart, const RCC_ClocksTypeDef *RCC_Clocks);
 /* Exported functions ---------------------------------------------------------*/
 /**
   * @brief  Initializes the UART mode according to the specified parameters in
   *         the UART_InitTypeDef and create the associated handle.
+  * @note   The handle is registered as a clock change notifier, BRR is
+  *         recomputed on every system clock change. The handle must stay
+  *         valid while the UART is in use.
   * @param  huart  Pointer to a UART_HandleTypeDef structure that contains
   *                the configuration information for the specified UART module.
   * @retval HAL status
@@ -48,14 +56,15 @@ HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
     HAL_PARAM_CHECK(IS_UART_HWCONTROL(huart->Init.UART_HardwareFlowControl));
     HAL_PARAM_CHECK(IS_UART_MODE(huart->Init.UART_Mode));
 
-    uint32_t          tmpreg = 0x00, apbclock = 0x00;
-    uint32_t          integerdivider = 0x00;
-    uint32_t          fractionaldivider = 0x00;
-    uint32_t          usartxbase = 0;
-    RCC_ClocksTypeDef RCC_ClocksStatus;
+    uint32_t          tmpreg = 0x00;
+
+    HAL_BOOT_PHASE_BEGIN(RCC_BOOT_PHASE_UART);
 
     if (huart->gState == HAL_UART_STATE_RESET)
     {
+        /* Peripheral clock, released by HAL_UART_DeInit() */
+        (void)HAL_RCC_ClockAcquire(RCC_APB2Periph_USART1, 0U);
+
         /* Init the low level hardware : GPIO, CLOCK */
         HAL_UART_MspInit(huart);
     }
@@ -69,7 +78,6 @@ HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
     {
     }
 
-    usartxbase = (uint32_t)huart->Instance;
     tmpreg = READ_REG(huart->Instance->CTLR2);
     tmpreg &= ~USART_CTLR2_STOP;
     tmpreg |= (uint32_t)huart->Init.UART_StopBits;
@@ -86,31 +94,64 @@ HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
     tmpreg |= huart->Init.UART_HardwareFlowControl;
     WRITE_REG(huart->Instance->CTLR3, (uint16_t)tmpreg);
 
-    HAL_RCC_GetClocksFreq(&RCC_ClocksStatus);
+    UART_SetBaudRate(huart, HAL_RCC_GetClockTree());
 
-    if (usartxbase == USART1_BASE)
+    /* Enable the peripheral */
+    __HAL_UART_ENABLE(huart);
+
+    /* Initialize the UART state */
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+
+    /* Follow system clock changes */
+    huart->ClockNotifier.Callback = HAL_UART_ClockChangeCallback;
+    huart->ClockNotifier.Context = huart;
+
+    HAL_BOOT_PHASE_END(RCC_BOOT_PHASE_UART);
+
+    return HAL_RCC_RegisterClockNotifier(&huart->ClockNotifier);
+}
+
+/**
+  * @brief  DeInitializes the UART peripheral.
+  * @note   The clock notifier is unregistered and the USART1 clock reference
+  *         taken by HAL_UART_Init() is released.
+  * @param  huart  Pointer to a UART_HandleTypeDef structure that contains
+  *                the configuration information for the specified UART module.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_UART_DeInit(UART_HandleTypeDef *huart)
+{
+    /* Check the UART handle allocation */
+    if (huart == NULL)
     {
-        apbclock = RCC_ClocksStatus.PCLK2_Frequency;
+        return HAL_ERROR;
     }
-    else
+
+    /* Check the parameters */
+    HAL_PARAM_CHECK(IS_UART_INSTANCE(huart->Instance));
+
+    if (huart->gState == HAL_UART_STATE_RESET)
     {
-        apbclock = RCC_ClocksStatus.PCLK1_Frequency;
+        return HAL_OK;
     }
 
-    integerdivider = ((25 * apbclock) / (4 * (huart->Init.UART_BaudRate)));
-    tmpreg = (integerdivider / 100) << 4;
-    fractionaldivider = integerdivider - (100 * (tmpreg >> 4));
-    tmpreg |= ((((fractionaldivider * 16) + 50) / 100)) & ((uint8_t)0x0F);
+    huart->gState = HAL_UART_STATE_BUSY;
 
-    WRITE_REG(huart->Instance->BRR, (uint16_t)tmpreg);
+    /* Disable the peripheral */
+    __HAL_UART_DISABLE(huart);
 
-    /* Enable the peripheral */
-    __HAL_UART_ENABLE(huart);
+    (void)HAL_RCC_UnregisterClockNotifier(&huart->ClockNotifier);
+
+    /* DeInit the low level hardware */
+    HAL_UART_MspDeInit(huart);
+
+    (void)HAL_RCC_ClockRelease(RCC_APB2Periph_USART1, 0U);
 
-    /* Initialize the UART state */
     huart->ErrorCode = HAL_UART_ERROR_NONE;
-    huart->gState = HAL_UART_STATE_READY;
-    huart->RxState = HAL_UART_STATE_READY;
+    huart->gState = HAL_UART_STATE_RESET;
+    huart->RxState = HAL_UART_STATE_RESET;
 
     return HAL_OK;
 }
@@ -130,6 +171,21 @@ __weak void HAL_UART_MspInit(UART_HandleTypeDef *huart)
     */
 }
 
+/**
+  * @brief  UART MSP DeInit.
+  * @param  huart  Pointer to a UART_HandleTypeDef structure that contains
+  *                the configuration information for the specified UART module.
+  * @retval None
+  */
+__weak void HAL_UART_MspDeInit(UART_HandleTypeDef *huart)
+{
+    /* Prevent unused argument(s) compilation warning */
+    UNUSED(huart);
+    /* NOTE: This function should not be modified, when the callback is needed,
+            the HAL_UART_MspDeInit could be implemented in the user file
+    */
+}
+
 /**
   * @brief  Sends an amount of data in blocking mode.
   * @note   When UART parity is not enabled (PCE = 0), and Word Length is configured to 9 bits (M1-M0 = 01),
@@ -144,78 +200,30 @@ __weak void HAL_UART_MspInit(UART_HandleTypeDef *huart)
   */
 HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
 {
-    const uint8_t  *pdata8bits;
-    const uint16_t *pdata16bits;
-    uint32_t tickstart = 0U;
-
-    /* Check that a Tx process is not already ongoing */
-    if (huart->gState == HAL_UART_STATE_READY)
-    {
-        if ((pData == NULL) || (Size == 0U))
-        {
-            return  HAL_ERROR;
-        }
-
-        huart->ErrorCode = HAL_UART_ERROR_NONE;
-        huart->gState = HAL_UART_STATE_BUSY_TX;
-
-        /* Init tickstart for timeout management */
-        tickstart = HAL_GetTick();
-
-        huart->TxXferSize = Size;
-        huart->TxXferCount = Size;
-
-        /* In case of 9bits/No Parity transfer, pData needs to be handled as a uint16_t pointer */
-        if ((huart->Init.UART_WordLength == UART_WORDLENGTH_9B) && (huart->Init.UART_Parity == UART_PARITY_NONE))
-        {
-            pdata8bits  = NULL;
-            pdata16bits = (const uint16_t *) pData;
-        }
-        else
-        {
-            pdata8bits  = pData;
-            pdata16bits = NULL;
-        }
-
-        while (huart->TxXferCount > 0U)
-        {
-            if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_TXE, RESET, tickstart, Timeout) != HAL_OK)
-            {
-                huart->gState = HAL_UART_STATE_READY;
-
-                return HAL_TIMEOUT;
-            }
-
-            if (pdata8bits == NULL)
-            {
-                WRITE_REG(huart->Instance->DATAR, (uint16_t)(*pdata16bits & 0x01FFU));
-                pdata16bits++;
-            }
-            else
-            {
-                WRITE_REG(huart->Instance->DATAR, (uint8_t)(*pdata8bits & 0xFFU));
-                pdata8bits++;
-            }
+    HAL_DeadlineTypeDef deadline;
 
-            huart->TxXferCount--;
-        }
+    /* Init deadline for timeout management */
+    HAL_DeadlineStart(&deadline, Timeout);
 
-        if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_TC, RESET, tickstart, Timeout) != HAL_OK)
-        {
-            huart->gState = HAL_UART_STATE_READY;
+    return UART_Transmit(huart, pData, Size, &deadline);
+}
 
-            return HAL_TIMEOUT;
-        }
+/**
+  * @brief  Sends an amount of data in blocking mode with a timeout in microseconds.
+  * @param  huart Pointer to a UART_HandleTypeDef structure that contains
+  *               the configuration information for the specified UART module.
+  * @param  pData Pointer to data buffer (u8 or u16 data elements).
+  * @param  Size  Amount of data elements (u8 or u16) to be sent
+  * @param  TimeoutUs Timeout duration of the whole transfer in microseconds
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_UART_Transmit_Us(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t TimeoutUs)
+{
+    HAL_DeadlineTypeDef deadline;
 
-        /* At end of Tx process, restore huart->gState to Ready */
-        huart->gState = HAL_UART_STATE_READY;
+    HAL_DeadlineStartUs(&deadline, TimeoutUs);
 
-        return HAL_OK;
-    }
-    else
-    {
-        return HAL_BUSY;
-    }
+    return UART_Transmit(huart, pData, Size, &deadline);
 }
 
 /**
@@ -232,78 +240,31 @@ HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pD
   */
 HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
 {
-    uint8_t  *pdata8bits;
-    uint16_t *pdata16bits;
-    uint32_t tickstart = 0U;
-
-    /* Check that a Rx process is not already ongoing */
-    if (huart->RxState == HAL_UART_STATE_READY)
-    {
-        if ((pData == NULL) || (Size == 0U))
-        {
-            return HAL_ERROR;
-        }
-
-        huart->ErrorCode = HAL_UART_ERROR_NONE;
-        huart->RxState = HAL_UART_STATE_BUSY_RX;
+    HAL_DeadlineTypeDef deadline;
 
-        /* Init tickstart for timeout management */
-        tickstart = HAL_GetTick();
-
-        huart->RxXferSize = Size;
-        huart->RxXferCount = Size;
-
-        /* In case of 9bits/No Parity transfer, pRxData needs to be handled as a uint16_t pointer */
-        if ((huart->Init.UART_WordLength == UART_WORDLENGTH_9B) && (huart->Init.UART_Parity == UART_PARITY_NONE))
-        {
-            pdata8bits  = NULL;
-            pdata16bits = (uint16_t *) pData;
-        }
-        else
-        {
-            pdata8bits  = pData;
-            pdata16bits = NULL;
-        }
+    /* Init deadline for timeout management */
+    HAL_DeadlineStart(&deadline, Timeout);
 
-        /* Check the remain data to be received */
-        while (huart->RxXferCount > 0U)
-        {
-            if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_RXNE, RESET, tickstart, Timeout) != HAL_OK)
-            {
-                huart->RxState = HAL_UART_STATE_READY;
-                return HAL_TIMEOUT;
-            }
+    return UART_Receive(huart, pData, Size, &deadline);
+}
 
-            if (pdata8bits == NULL)
-            {
-                *pdata16bits = (uint16_t)(READ_REG(huart->Instance->DATAR) & 0x01FF);
-                pdata16bits++;
-            }
-            else
-            {
-                if ((huart->Init.UART_WordLength == UART_WORDLENGTH_9B) ||
-                    ((huart->Init.UART_WordLength == UART_WORDLENGTH_8B) && (huart->Init.UART_Parity == UART_PARITY_NONE)))
-                {
-                    *pdata8bits = (uint8_t)(READ_REG(huart->Instance->DATAR) & (uint8_t)0x00FF);
-                }
-                else
-                {
-                    *pdata8bits = (uint8_t)(READ_REG(huart->Instance->DATAR) & (uint8_t)0x007F);
-                }
-                pdata8bits++;
-            }
-            huart->RxXferCount--;
-        }
+/**
+  * @brief  Receives an amount of data in blocking mode with a timeout in microseconds.
+  * @note   Use Size = 1 to enforce an inter-byte timeout.
+  * @param  huart Pointer to a UART_HandleTypeDef structure that contains
+  *               the configuration information for the specified UART module.
+  * @param  pData Pointer to data buffer (u8 or u16 data elements).
+  * @param  Size  Amount of data elements (u8 or u16) to be received.
+  * @param  TimeoutUs Timeout duration of the whole transfer in microseconds
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_UART_Receive_Us(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t TimeoutUs)
+{
+    HAL_DeadlineTypeDef deadline;
 
-        /* At end of Rx process, restore huart->RxState to Ready */
-        huart->RxState = HAL_UART_STATE_READY;
+    HAL_DeadlineStartUs(&deadline, TimeoutUs);
 
-        return HAL_OK;
-    }
-    else
-    {
-        return HAL_BUSY;
-    }
+    return UART_Receive(huart, pData, Size, &deadline);
 }
 
 /**
@@ -515,7 +476,225 @@ __weak void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
     */
 }
 
+/**
+  * @brief  Clock change notifier callback, recomputes BRR for the new APB clock.
+  * @note   Registered by HAL_UART_Init() with the handle as Context.
+  * @param  RCC_Clocks new clock frequencies.
+  * @param  Context    pointer to a UART_HandleTypeDef structure.
+  * @retval None
+  */
+void HAL_UART_ClockChangeCallback(const RCC_ClocksTypeDef *RCC_Clocks, void *Context)
+{
+    UART_HandleTypeDef *huart = (UART_HandleTypeDef *)Context;
+
+    if ((huart == NULL) || (huart->gState == HAL_UART_STATE_RESET))
+    {
+        return;
+    }
+
+    UART_SetBaudRate(huart, RCC_Clocks);
+}
+
 /* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Sends an amount of data in blocking mode.
+  * @note   When UART parity is not enabled (PCE = 0), and Word Length is configured to 9 bits (M1-M0 = 01),
+  *         the sent data is handled as a set of u16. In this case, Size must indicate the number
+  *         of u16 provided through pData.
+  * @param  huart Pointer to a UART_HandleTypeDef structure that contains
+  *               the configuration information for the specified UART module.
+  * @param  pData Pointer to data buffer (u8 or u16 data elements).
+  * @param  Size  Amount of data elements (u8 or u16) to be sent
+  * @param  Deadline Deadline of the whole transfer
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size,
+                                       const HAL_DeadlineTypeDef *Deadline)
+{
+    const uint8_t  *pdata8bits;
+    const uint16_t *pdata16bits;
+
+    /* Check that a Tx process is not already ongoing */
+    if (huart->gState == HAL_UART_STATE_READY)
+    {
+        if ((pData == NULL) || (Size == 0U))
+        {
+            return  HAL_ERROR;
+        }
+
+        huart->ErrorCode = HAL_UART_ERROR_NONE;
+        huart->gState = HAL_UART_STATE_BUSY_TX;
+
+        huart->TxXferSize = Size;
+        huart->TxXferCount = Size;
+
+        /* In case of 9bits/No Parity transfer, pData needs to be handled as a uint16_t pointer */
+        if ((huart->Init.UART_WordLength == UART_WORDLENGTH_9B) && (huart->Init.UART_Parity == UART_PARITY_NONE))
+        {
+            pdata8bits  = NULL;
+            pdata16bits = (const uint16_t *) pData;
+        }
+        else
+        {
+            pdata8bits  = pData;
+            pdata16bits = NULL;
+        }
+
+        while (huart->TxXferCount > 0U)
+        {
+            if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_TXE, RESET, Deadline) != HAL_OK)
+            {
+                huart->gState = HAL_UART_STATE_READY;
+
+                return HAL_TIMEOUT;
+            }
+
+            if (pdata8bits == NULL)
+            {
+                WRITE_REG(huart->Instance->DATAR, (uint16_t)(*pdata16bits & 0x01FFU));
+                pdata16bits++;
+            }
+            else
+            {
+                WRITE_REG(huart->Instance->DATAR, (uint8_t)(*pdata8bits & 0xFFU));
+                pdata8bits++;
+            }
+
+            huart->TxXferCount--;
+        }
+
+        if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_TC, RESET, Deadline) != HAL_OK)
+        {
+            huart->gState = HAL_UART_STATE_READY;
+
+            return HAL_TIMEOUT;
+        }
+
+        /* At end of Tx process, restore huart->gState to Ready */
+        huart->gState = HAL_UART_STATE_READY;
+
+        return HAL_OK;
+    }
+    else
+    {
+        return HAL_BUSY;
+    }
+}
+
+/**
+  * @brief  Receives an amount of data in blocking mode.
+  * @note   When UART parity is not enabled (PCE = 0), and Word Length is configured to 9 bits (M1-M0 = 01),
+  *         the received data is handled as a set of u16. In this case, Size must indicate the number
+  *         of u16 available through pData.
+  * @param  huart Pointer to a UART_HandleTypeDef structure that contains
+  *               the configuration information for the specified UART module.
+  * @param  pData Pointer to data buffer (u8 or u16 data elements).
+  * @param  Size  Amount of data elements (u8 or u16) to be received.
+  * @param  Deadline Deadline of the whole transfer
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size,
+                                      const HAL_DeadlineTypeDef *Deadline)
+{
+    uint8_t  *pdata8bits;
+    uint16_t *pdata16bits;
+
+    /* Check that a Rx process is not already ongoing */
+    if (huart->RxState == HAL_UART_STATE_READY)
+    {
+        if ((pData == NULL) || (Size == 0U))
+        {
+            return HAL_ERROR;
+        }
+
+        huart->ErrorCode = HAL_UART_ERROR_NONE;
+        huart->RxState = HAL_UART_STATE_BUSY_RX;
+
+        huart->RxXferSize = Size;
+        huart->RxXferCount = Size;
+
+        /* In case of 9bits/No Parity transfer, pRxData needs to be handled as a uint16_t pointer */
+        if ((huart->Init.UART_WordLength == UART_WORDLENGTH_9B) && (huart->Init.UART_Parity == UART_PARITY_NONE))
+        {
+            pdata8bits  = NULL;
+            pdata16bits = (uint16_t *) pData;
+        }
+        else
+        {
+            pdata8bits  = pData;
+            pdata16bits = NULL;
+        }
+
+        /* Check the remain data to be received */
+        while (huart->RxXferCount > 0U)
+        {
+            if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_RXNE, RESET, Deadline) != HAL_OK)
+            {
+                huart->RxState = HAL_UART_STATE_READY;
+                return HAL_TIMEOUT;
+            }
+
+            if (pdata8bits == NULL)
+            {
+                *pdata16bits = (uint16_t)(READ_REG(huart->Instance->DATAR) & 0x01FF);
+                pdata16bits++;
+            }
+            else
+            {
+                if ((huart->Init.UART_WordLength == UART_WORDLENGTH_9B) ||
+                    ((huart->Init.UART_WordLength == UART_WORDLENGTH_8B) && (huart->Init.UART_Parity == UART_PARITY_NONE)))
+                {
+                    *pdata8bits = (uint8_t)(READ_REG(huart->Instance->DATAR) & (uint8_t)0x00FF);
+                }
+                else
+                {
+                    *pdata8bits = (uint8_t)(READ_REG(huart->Instance->DATAR) & (uint8_t)0x007F);
+                }
+                pdata8bits++;
+            }
+            huart->RxXferCount--;
+        }
+
+        /* At end of Rx process, restore huart->RxState to Ready */
+        huart->RxState = HAL_UART_STATE_READY;
+
+        return HAL_OK;
+    }
+    else
+    {
+        return HAL_BUSY;
+    }
+}
+
+/**
+  * @brief  Program the BRR register from the handle baud rate and the APB clock.
+  * @param  huart      UART handle.
+  * @param  RCC_Clocks current clock frequencies.
+  * @retval None
+  */
+static void UART_SetBaudRate(UART_HandleTypeDef *huart, const RCC_ClocksTypeDef *RCC_Clocks)
+{
+    uint32_t tmpreg = 0x00, apbclock = 0x00;
+    uint32_t integerdivider = 0x00;
+    uint32_t fractionaldivider = 0x00;
+
+    if ((uint32_t)huart->Instance == USART1_BASE)
+    {
+        apbclock = RCC_Clocks->PCLK2_Frequency;
+    }
+    else
+    {
+        apbclock = RCC_Clocks->PCLK1_Frequency;
+    }
+
+    integerdivider = ((25 * apbclock) / (4 * (huart->Init.UART_BaudRate)));
+    tmpreg = (integerdivider / 100) << 4;
+    fractionaldivider = integerdivider - (100 * (tmpreg >> 4));
+    tmpreg |= ((((fractionaldivider * 16) + 50) / 100)) & ((uint8_t)0x0F);
+
+    WRITE_REG(huart->Instance->BRR, (uint16_t)tmpreg);
+}
+
 /**
   * @brief  This function handles UART Communication Timeout. It waits
   *         until a flag is no longer in the specified status.
@@ -523,18 +702,17 @@ __weak void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
   *                the configuration information for the specified UART module.
   * @param  Flag specifies the UART flag to check.
   * @param  Status The actual Flag status (SET or RESET).
-  * @param  Tickstart Tick start value
-  * @param  Timeout Timeout duration
+  * @param  Deadline Deadline of the whole transfer
   * @retval HAL status
   */
 static HAL_StatusTypeDef UART_WaitOnFlagUntilTimeout(UART_HandleTypeDef *huart, uint32_t Flag, FlagStatus Status,
-                                                     uint32_t Tickstart, uint32_t Timeout)
+                                                     const HAL_DeadlineTypeDef *Deadline)
 {
     /* Wait until flag is set */
     while ((__HAL_UART_GET_FLAG(huart, Flag) ? SET : RESET) == Status)
     {
         /* Check for the Timeout */
-        if ((Timeout != HAL_MAX_DELAY) && HAL_TickExpired(Tickstart, Timeout) || (Timeout == 0U))
+        if (HAL_DeadlineExpired(Deadline) != FALSE)
         {
             return HAL_TIMEOUT;
         }
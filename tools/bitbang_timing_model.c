@@ -0,0 +1,305 @@
+/********************************** (C) COPYRIGHT  *******************************
+ * File Name          : bitbang_timing_model.c
+ * Author             : truongtl
+ * Version            : V1.0
+ * Date               : 2026/10/19
+ * Description        : Host-side timing model of the bit-bang engines.
+ *                      Replays the loop counts computed by the driver through
+ *                      the cycle cost of the emitted instruction sequences and
+ *                      checks the WS2812, 1-Wire and software UART waveforms
+ *                      at every clock profile.
+ *
+ *                      cc -std=c99 -Wall -o bitbang_timing_model bitbang_timing_model.c
+ *                      ./bitbang_timing_model      (exit status 1 on a violation)
+ *
+ *                      The instruction counts below follow the -Os listing of
+ *                      ch32v00x_hal_bitbang.c (riscv-none-elf-objdump -d);
+ *                      update them when that code or the compiler changes.
+ *                      The per class costs are the QingKe V2 pipeline costs
+ *                      assumed by this model, confirm them against a scope
+ *                      capture when porting to a new core revision.
+ *********************************************************************************
+ * Copyright (c) 2025 Developed by truongtl (Truong Tran)
+ *******************************************************************************/
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+/* Private typedef -----------------------------------------------------------*/
+/* Cycle cost of one instruction of each class */
+typedef struct
+{
+    uint32_t Alu;            /* addi, mv, and, srli, ... */
+
+    uint32_t Load;           /* lw from SRAM or a peripheral */
+
+    uint32_t Store;          /* sw to BSHR/BCR */
+
+    uint32_t Csr;            /* csrrci / csrs */
+
+    uint32_t Taken;          /* taken branch, refetch included */
+
+    uint32_t NotTaken;       /* branch falling through */
+} MODEL_CostTypeDef;
+
+/* Instruction mix of a straight-line sequence */
+typedef struct
+{
+    uint8_t Alu;
+
+    uint8_t Load;
+
+    uint8_t Store;
+
+    uint8_t Csr;
+
+    uint8_t Taken;
+
+    uint8_t NotTaken;
+} MODEL_SeqTypeDef;
+
+/* Clock profile, as in RCC_ProfileTable */
+typedef struct
+{
+    const char *Name;
+
+    uint32_t Hclk;
+
+    uint32_t Latency;        /* Flash wait states, 1 above RCC_FLASH_LATENCY0_MAX_HZ */
+} MODEL_ProfileTypeDef;
+/* Private define ------------------------------------------------------------*/
+/* Copied from ch32v00x_hal_bitbang.c: the driver's guesses under test */
+#define BITBANG_CAL_LOOPS          256U
+#define BITBANG_HIGH_OVERHEAD      2U
+#define BITBANG_LOW_OVERHEAD       14U
+#define BITBANG_UART_OVERHEAD      8U
+
+#define WS2812_T0H_NS              400U
+#define WS2812_T1H_NS              800U
+#define WS2812_T0L_NS              850U
+#define WS2812_T1L_NS              450U
+#define WS2812_TOL_NS              150U
+#define WS2812_LOW_MAX_NS          5000U
+
+#define OW_A_US                    6U
+#define OW_C_US                    60U
+#define OW_E_US                    9U
+
+/* Software UART bit period tolerance, per mille (8N1 sampled mid-bit over 10 bits) */
+#define UART_TOL_PERMILLE          20U
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Flash latency 1 adds a wait state on every non sequential fetch */
+static const MODEL_CostTypeDef ModelCost[2] =
+{
+    { 1U, 2U, 1U, 1U, 3U, 1U },   /* 0 wait state */
+    { 1U, 2U, 1U, 1U, 4U, 1U },   /* 1 wait state */
+};
+
+/* HAL_BITBANG_Spin(): addi + bnez per iteration, the last bnez falls through */
+static const MODEL_SeqTypeDef SeqSpinIter = { 1U, 0U, 0U, 0U, 1U, 0U };
+static const MODEL_SeqTypeDef SeqSpinLast = { 1U, 0U, 0U, 0U, 0U, 1U };
+
+/* BITBANG_Calibrate(): li loops between the two CNT loads, second load sampled */
+static const MODEL_SeqTypeDef SeqCal = { 1U, 1U, 0U, 0U, 0U, 0U };
+
+/* WS2812 high: sw BSHR | mv loops | spin | sw BCR */
+static const MODEL_SeqTypeDef SeqWsHigh = { 1U, 0U, 1U, 0U, 0U, 0U };
+
+/* WS2812 low: sw BCR | mv loops | spin | srli mask, bnez mask,
+ * and bit, beqz, lw high, lw low | sw BSHR */
+static const MODEL_SeqTypeDef SeqWsLow = { 3U, 2U, 1U, 0U, 2U, 0U };
+
+/* Extra cost of the low phase closing a byte: addi size, lbu byte, li mask, bnez size */
+static const MODEL_SeqTypeDef SeqWsByte = { 2U, 1U, 0U, 0U, 1U, 0U };
+
+/* 1-Wire write '1' low: sw BCR | bnez bit (falls through), mv loops | spin | sw BSHR */
+static const MODEL_SeqTypeDef SeqOwA = { 1U, 0U, 1U, 0U, 0U, 1U };
+
+/* 1-Wire write '0' low: sw BCR | beqz bit (taken), mv loops | spin | sw BSHR */
+static const MODEL_SeqTypeDef SeqOwC = { 1U, 0U, 1U, 0U, 1U, 0U };
+
+/* 1-Wire sample: sw BSHR | mv loops | spin | lw INDR */
+static const MODEL_SeqTypeDef SeqOwE = { 1U, 0U, 0U, 0U, 0U, 0U };
+
+/* Software UART Tx bit: sw | mv loops | spin | addi bit, srli frame, bltu bit,
+ * andi level, beqz level | sw */
+static const MODEL_SeqTypeDef SeqUartBit = { 4U, 0U, 1U, 0U, 2U, 0U };
+
+static const MODEL_ProfileTypeDef ModelProfile[] =
+{
+    { "PLL 48MHz",   48000000U, 1U },
+    { "HSI 24MHz",   24000000U, 0U },
+    { "HSI 8MHz",     8000000U, 0U },
+    { "HSI 1.5MHz",   1500000U, 0U },
+};
+
+static const uint32_t ModelBaud[] = { 9600U, 115200U };
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t MODEL_SeqCycles(const MODEL_SeqTypeDef *Seq, const MODEL_CostTypeDef *Cost);
+static uint32_t MODEL_SpinCycles(uint32_t Loops, const MODEL_CostTypeDef *Cost);
+static uint32_t MODEL_CyclesToLoops(uint32_t Cycles, uint32_t Overhead, uint32_t LoopCycles16);
+static uint32_t MODEL_NsToLoops(uint32_t Ns, uint32_t Overhead, uint32_t Hclk, uint32_t LoopCycles16);
+static uint32_t MODEL_CyclesToNs(uint32_t Cycles, uint32_t Hclk);
+static uint32_t MODEL_Check(const char *What, uint32_t Value, uint32_t Min, uint32_t Max);
+/* Exported functions --------------------------------------------------------*/
+int main(void)
+{
+    uint32_t failures = 0x00;
+    uint32_t p = 0x00, b = 0x00;
+
+    for (p = 0x00; p < sizeof(ModelProfile) / sizeof(ModelProfile[0]); p++)
+    {
+        const MODEL_ProfileTypeDef *prof = &ModelProfile[p];
+        const MODEL_CostTypeDef *cost = &ModelCost[prof->Latency];
+        uint32_t hclk = prof->Hclk;
+        uint32_t delta = 0x00, loop16 = 0x00;
+        uint32_t t0h = 0x00, t1h = 0x00, t0l = 0x00, t1l = 0x00, byte_extra = 0x00;
+        uint32_t ow_a = 0x00, ow_c = 0x00, ow_e = 0x00;
+
+        printf("%s (HCLK %lu Hz, %lu wait state)\n", prof->Name, (unsigned long)hclk, (unsigned long)prof->Latency);
+
+        /* What BITBANG_Calibrate() measures on this core */
+        delta = MODEL_SpinCycles(BITBANG_CAL_LOOPS, cost) + MODEL_SeqCycles(&SeqCal, cost);
+        loop16 = (delta + 8U) >> 4;
+
+        /* WS2812, only meaningful when one cycle is well below the tolerance */
+        if (MODEL_CyclesToNs(1U, hclk) * 4U <= WS2812_TOL_NS * 2U)
+        {
+            t0h = MODEL_SeqCycles(&SeqWsHigh, cost) +
+                  MODEL_SpinCycles(MODEL_NsToLoops(WS2812_T0H_NS, BITBANG_HIGH_OVERHEAD, hclk, loop16), cost);
+            t1h = MODEL_SeqCycles(&SeqWsHigh, cost) +
+                  MODEL_SpinCycles(MODEL_NsToLoops(WS2812_T1H_NS, BITBANG_HIGH_OVERHEAD, hclk, loop16), cost);
+            t0l = MODEL_SeqCycles(&SeqWsLow, cost) +
+                  MODEL_SpinCycles(MODEL_NsToLoops(WS2812_T0L_NS, BITBANG_LOW_OVERHEAD, hclk, loop16), cost);
+            t1l = MODEL_SeqCycles(&SeqWsLow, cost) +
+                  MODEL_SpinCycles(MODEL_NsToLoops(WS2812_T1L_NS, BITBANG_LOW_OVERHEAD, hclk, loop16), cost);
+            byte_extra = MODEL_SeqCycles(&SeqWsByte, cost);
+
+            failures += MODEL_Check("WS2812 T0H", MODEL_CyclesToNs(t0h, hclk),
+                                    WS2812_T0H_NS - WS2812_TOL_NS, WS2812_T0H_NS + WS2812_TOL_NS);
+            failures += MODEL_Check("WS2812 T1H", MODEL_CyclesToNs(t1h, hclk),
+                                    WS2812_T1H_NS - WS2812_TOL_NS, WS2812_T1H_NS + WS2812_TOL_NS);
+            failures += MODEL_Check("WS2812 T0L", MODEL_CyclesToNs(t0l, hclk),
+                                    WS2812_T0L_NS - WS2812_TOL_NS, WS2812_LOW_MAX_NS);
+            failures += MODEL_Check("WS2812 T1L", MODEL_CyclesToNs(t1l, hclk),
+                                    WS2812_T1L_NS - WS2812_TOL_NS, WS2812_LOW_MAX_NS);
+            failures += MODEL_Check("WS2812 T0L, byte end", MODEL_CyclesToNs(t0l + byte_extra, hclk),
+                                    WS2812_T0L_NS - WS2812_TOL_NS, WS2812_LOW_MAX_NS);
+        }
+        else
+        {
+            printf("  WS2812 not supported, one cycle is %lu ns\n", (unsigned long)MODEL_CyclesToNs(1U, hclk));
+        }
+
+        /* 1-Wire standard speed */
+        ow_a = MODEL_SeqCycles(&SeqOwA, cost) +
+               MODEL_SpinCycles(MODEL_NsToLoops(OW_A_US * 1000U, BITBANG_HIGH_OVERHEAD, hclk, loop16), cost);
+        ow_c = MODEL_SeqCycles(&SeqOwC, cost) +
+               MODEL_SpinCycles(MODEL_NsToLoops(OW_C_US * 1000U, BITBANG_HIGH_OVERHEAD, hclk, loop16), cost);
+        ow_e = MODEL_SeqCycles(&SeqOwE, cost) +
+               MODEL_SpinCycles(MODEL_NsToLoops(OW_E_US * 1000U, BITBANG_HIGH_OVERHEAD, hclk, loop16), cost);
+
+        failures += MODEL_Check("1-Wire write 1 low", MODEL_CyclesToNs(ow_a, hclk), 1000U, 15000U);
+        failures += MODEL_Check("1-Wire write 0 low", MODEL_CyclesToNs(ow_c, hclk), 60000U, 120000U);
+        failures += MODEL_Check("1-Wire sample", MODEL_CyclesToNs(ow_a + ow_e, hclk), 0U, 15000U);
+
+        /* Software UART, bit period error over a frame */
+        for (b = 0x00; b < sizeof(ModelBaud) / sizeof(ModelBaud[0]); b++)
+        {
+            uint32_t baud = ModelBaud[b];
+            uint32_t bit_cycles = hclk / baud;
+            uint32_t nominal = 0x00, actual = 0x00;
+            char what[40];
+
+            if (bit_cycles <= (MODEL_SeqCycles(&SeqUartBit, cost) + MODEL_SpinCycles(1U, cost)))
+            {
+                printf("  UART %lu baud not supported\n", (unsigned long)baud);
+                continue;
+            }
+
+            nominal = (uint32_t)(((uint64_t)hclk * 1000U) / baud);   /* bit period, 1/1000 cycle */
+            actual = (MODEL_SeqCycles(&SeqUartBit, cost) +
+                      MODEL_SpinCycles(MODEL_CyclesToLoops(bit_cycles, BITBANG_UART_OVERHEAD, loop16), cost)) * 1000U;
+
+            snprintf(what, sizeof(what), "UART %lu bit, permille", (unsigned long)baud);
+            failures += MODEL_Check(what, (uint32_t)(((uint64_t)actual * 1000U) / nominal),
+                                    1000U - UART_TOL_PERMILLE, 1000U + UART_TOL_PERMILLE);
+        }
+    }
+
+    printf("%s, %lu violation(s)\n", (failures == 0U) ? "PASS" : "FAIL", (unsigned long)failures);
+
+    return (failures == 0U) ? 0 : 1;
+}
+
+/* Privated functions ---------------------------------------------------------*/
+/**
+  * @brief  Cycles spent in a straight-line sequence.
+  * @retval cycles
+  */
+static uint32_t MODEL_SeqCycles(const MODEL_SeqTypeDef *Seq, const MODEL_CostTypeDef *Cost)
+{
+    return (Seq->Alu * Cost->Alu) + (Seq->Load * Cost->Load) + (Seq->Store * Cost->Store) +
+           (Seq->Csr * Cost->Csr) + (Seq->Taken * Cost->Taken) + (Seq->NotTaken * Cost->NotTaken);
+}
+
+/**
+  * @brief  Cycles spent in HAL_BITBANG_Spin(Loops).
+  * @retval cycles
+  */
+static uint32_t MODEL_SpinCycles(uint32_t Loops, const MODEL_CostTypeDef *Cost)
+{
+    return ((Loops - 1U) * MODEL_SeqCycles(&SeqSpinIter, Cost)) + MODEL_SeqCycles(&SeqSpinLast, Cost);
+}
+
+/**
+  * @brief  BITBANG_CyclesToLoops() of the driver.
+  * @retval loops, at least 1.
+  */
+static uint32_t MODEL_CyclesToLoops(uint32_t Cycles, uint32_t Overhead, uint32_t LoopCycles16)
+{
+    uint32_t loops = 0x00;
+
+    if (Cycles <= Overhead)
+    {
+        return 1U;
+    }
+
+    loops = (uint32_t)((((uint64_t)(Cycles - Overhead) << 4) + (LoopCycles16 >> 1)) / LoopCycles16);
+
+    return (loops == 0U) ? 1U : loops;
+}
+
+/**
+  * @brief  BITBANG_NsToLoops() of the driver.
+  * @retval loops, at least 1.
+  */
+static uint32_t MODEL_NsToLoops(uint32_t Ns, uint32_t Overhead, uint32_t Hclk, uint32_t LoopCycles16)
+{
+    uint32_t cycles = (uint32_t)(((uint64_t)Ns * Hclk + 500000000U) / 1000000000U);
+
+    return MODEL_CyclesToLoops(cycles, Overhead, LoopCycles16);
+}
+
+/**
+  * @brief  Converts cycles to nanoseconds.
+  * @retval nanoseconds
+  */
+static uint32_t MODEL_CyclesToNs(uint32_t Cycles, uint32_t Hclk)
+{
+    return (uint32_t)(((uint64_t)Cycles * 1000000000U) / Hclk);
+}
+
+/**
+  * @brief  Prints one waveform check.
+  * @retval 1 on a violation, 0 otherwise.
+  */
+static uint32_t MODEL_Check(const char *What, uint32_t Value, uint32_t Min, uint32_t Max)
+{
+    uint32_t bad = ((Value < Min) || (Value > Max)) ? 1U : 0U;
+
+    printf("  %-24s %7lu  [%lu..%lu] %s\n", What, (unsigned long)Value,
+           (unsigned long)Min, (unsigned long)Max, (bad != 0U) ? "FAIL" : "ok");
+
+    return bad;
+}